@@ -0,0 +1,117 @@
+#ifndef AGGREGATE_H
+#define AGGREGATE_H
+
+#include <vector>
+
+#include "catalog.h"
+#include "partition.h"
+#include "query.h"
+
+// define if debug output wanted
+// #define DEBUGAGG
+
+// Memory (in bytes) the groups held by the hash aggregate may occupy.
+// Tuples of further groups are spilled to disk and aggregated later.
+const int AGG_MEMBYTES = 512 * 1024;
+
+// Number of partitions spilled tuples are split into.
+const int AGG_PARTS = 16;
+
+// Number of times a partition whose groups still do not fit is split
+// again; past that its groups are kept in memory regardless.
+const int AGG_MAXDEPTH = 3;
+
+// An output attribute of an aggregate query: a grouping attribute (func
+// is NoAgg) or an aggregate function of an input attribute.
+struct AggCol {
+    AggFunc func;  // aggregate function
+    AttrDesc in;   // input attribute; attrLen is 0 for count(*)
+    int keyOff;    // grouping attribute: offset of its value in the key
+    int stateOff;  // aggregate: offset of its running state in a group
+    int outType;   // type of the output attribute
+    int outLen;    // length of the output attribute
+};
+
+// Hash aggregation.
+//
+// Groups live in a hash table of fixed size entries, each holding the
+// group's key (its grouping attribute values) and the running state of
+// every aggregate. Once the table is full, tuples of groups not yet in
+// the table are spilled to the partitions of a Partition class, which
+// are aggregated in turn after the groups in memory have been output. If
+// the input arrived in order of its single grouping attribute up to the
+// point the table filled, it is instead aggregated one group at a time
+// from a SortedFile, which needs no memory for groups at all.
+
+class HashAggregate {
+   public:
+    HashAggregate(const int groupCnt,           // number of grouping attrs
+                  const AttrDesc groupDescs[],  // grouping attributes
+                  const int colCnt,             // number of output attrs
+                  const AggCol cols[],          // output attributes
+                  Status& status);
+    ~HashAggregate();
+
+    // aggregate the tuples of relation satisfying the given filter (as
+    // for HeapFileScan::startScan), writing one tuple per group to
+    // result; resultCnt returns the number of groups
+    const Status execute(const string& relation, const int offset,
+                         const int length, const Datatype type,
+                         const char* filter, const Operator op,
+                         InsertFileScan& result, int& resultCnt);
+
+   private:
+    // aggregate the tuples of relation fileName, or of partition in if it
+    // is not NULL; spilled tuples go to partitions named after spillName
+    const Status hashPass(const string& fileName, SpillFile* in,
+                          const string& spillName, const int depth,
+                          InsertFileScan& result, int& resultCnt);
+
+    // aggregate relation, in order of its grouping attribute, from a
+    // SortedFile
+    const Status sortPass(const string& relation, InsertFileScan& result,
+                          int& resultCnt);
+
+    // copy the grouping attribute values of rec into key
+    void makeKey(const char* rec, char* key) const;
+
+    // hash value of a key
+    const unsigned int hashKey(const char* key, const int seed) const;
+
+    // set up the aggregate states of a new group from its first tuple,
+    // and fold in the further tuples of the group
+    void initGroup(char* entry, const char* rec) const;
+    void updateGroup(char* entry, const char* rec) const;
+
+    // write the output tuple of a group to result
+    const Status outputGroup(const char* entry, InsertFileScan& result);
+
+    // set up an empty table with room for capacity groups
+    const Status resetTable(const int capacity);
+
+    // partition hash function handed to the Partition class; arg is the
+    // AggPartArg of the pass that spills
+    static const int partHash(const Record& rec, const int P, void* arg);
+
+    int groupCnt;                  // number of grouping attributes
+    std::vector<AttrDesc> groups;  // grouping attributes
+    std::vector<AggCol> cols;      // output attributes
+    int keyLen;                    // bytes of grouping attribute values
+    int stateOff;                  // offset of the states in an entry
+    int entryLen;                  // bytes per group in the table
+    int outLen;                    // length of an output tuple
+
+    char* entries;             // the groups, entryLen bytes each
+    int capacity;              // number of entries allocated
+    int used;                  // number of groups in the table
+    std::vector<int> buckets;  // first entry of each hash chain, or -1
+
+    // filter applied to the input relation
+    int fltOffset;
+    int fltLength;
+    Datatype fltType;
+    const char* filter;
+    Operator fltOp;
+};
+
+#endif
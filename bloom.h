@@ -0,0 +1,40 @@
+#ifndef BLOOM_H
+#define BLOOM_H
+
+// Blocked bloom filter over 32-bit hash values. Every key sets (and is
+// tested against) three bits of a single 64-bit word, so an insert or a
+// lookup touches one cache line. Callers supply well mixed hash values;
+// different bits of the hash select the word and the bits within it.
+
+class BloomFilter {
+   public:
+    BloomFilter(const int expected,         // expected number of keys
+                const int bitsPerKey = 8);  // filter bits per key
+    ~BloomFilter();
+
+    // add a key with hash value h
+    void add(const unsigned int h) { words[wordOf(h)] |= bitsOf(h); }
+
+    // false if no key with hash value h was added; true if one may have been
+    bool mayContain(const unsigned int h) const {
+        unsigned long long bits = bitsOf(h);
+        return (words[wordOf(h)] & bits) == bits;
+    }
+
+    // remove all keys
+    void clear();
+
+   private:
+    unsigned long long* words;  // the filter
+    int logWords;               // filter has 2^logWords words
+
+    unsigned int wordOf(const unsigned int h) const {
+        return (h * 0x9E3779B1u) >> (32 - logWords);
+    }
+    static unsigned long long bitsOf(const unsigned int h) {
+        return (1ULL << (h & 63)) | (1ULL << ((h >> 6) & 63)) |
+               (1ULL << ((h >> 12) & 63));
+    }
+};
+
+#endif
@@ -1,7 +1,9 @@
 #ifndef BUF_H
 #define BUF_H
 
+#include "bufTrace.h"
 #include "db.h"
+#include "ioEngine.h"
 // define if debug output wanted
 // #define DEBUGBUF
 
@@ -46,13 +48,14 @@ class BufDesc {
     friend class BufMgr;
 
    private:
-    File* file;   // pointer to file object
-    int pageNo;   // page within file
-    int frameNo;  // frame # of frame
-    int pinCnt;   // number of times this page has been pinned
-    bool dirty;   // true if dirty;  false otherwise
-    bool valid;   // true if page is valid
-    bool refbit;  // has this buffer frame been reference recently
+    File* file;      // pointer to file object
+    int pageNo;      // page within file
+    int frameNo;     // frame # of frame
+    int pinCnt;      // number of times this page has been pinned
+    bool dirty;      // true if dirty;  false otherwise
+    bool valid;      // true if page is valid
+    bool refbit;     // has this buffer frame been reference recently
+    bool ioPending;  // asynchronous read or write of the frame in flight
 
     void Clear() {  // initialize buffer frame for a new user
         pinCnt = 0;
@@ -60,6 +63,7 @@ class BufDesc {
         pageNo = -1;
         dirty = false;
         valid = false;
+        ioPending = false;
     };
 
     void Set(File* filePtr, int pageNum) {
@@ -75,11 +79,13 @@ class BufDesc {
 };
 
 struct BufStats {
-    int accesses;    // Total number of accesses to buffer pool
+    int accesses;    // Number of readPage and allocPage calls
+    int hits;        // Number of readPage calls that found the page cached
     int diskreads;   // Number of pages read from disk (including allocs)
     int diskwrites;  // Number of pages written back to disk
+    int skipped;     // Number of data pages scans passed over (zone maps)
 
-    void clear() { accesses = diskreads = diskwrites = 0; }
+    void clear() { accesses = hits = diskreads = diskwrites = skipped = 0; }
 
     BufStats() { clear(); }
 };
@@ -91,32 +97,56 @@ class BufMgr {
     BufHashTbl* hashTable;  // hash table mapping (File, page) to frame
     BufDesc* bufTable;      // vector of status info, 1 per page
     BufStats bufStats;      // buffer pool statistics
+    IOEngine* io;           // asynchronous I/O, NULL for synchronous only
+    IORequest* ioReqs;      // one request per frame
+    BufTrace* trace;        // access trace being written, or NULL
 
     const Status allocBuf(int& frame);  // allocate a free frame.
     const void releaseBuf(int frame);   // return unused frame to end of list
+    const Status startIO(const int frame, const bool write, const bool more);
+    const Status reap();                      // complete one request
+    const Status waitFrame(const int frame);  // wait for the frame's I/O
+    const Status writeDirty(const File* file);  // write dirty pages of file
     void advanceClock() { clockHand = (clockHand + 1) % numBufs; }
 
    public:
     Page* bufPool;  // actual buffer pool
 
-    BufMgr(const int bufs);
+    // with an I/O engine (owned by the buffer manager from then on),
+    // prefetches and write-back of evicted and flushed pages are
+    // asynchronous
+    BufMgr(const int bufs, IOEngine* engine = NULL);
     ~BufMgr();
 
     const Status readPage(File* file, const int PageNo, Page*& page);
     const Status unPinPage(File* file, const int PageNo, const bool dirty);
     const Status allocPage(File* file, int& PageNo, Page*& page);
+    // start reading a page that will be needed soon; the page is not
+    // pinned. A no-op without an I/O engine.
+    const Status prefetch(File* file, const int PageNo);
     // allocates a new, empty page
     const Status flushFile(
         const File* file);  // writing out all dirty pages of the file
+    const Status writeBack(
+        const File* file);  // write dirty pages of file, keeping them
     const Status disposePage(File* file,
                              const int PageNo);  // dispose of page in file
     void printSelf();
 
+    // record every readPage, allocPage, unPinPage and disposePage call
+    // in trace file fileName (replacing a trace being written), for
+    // replay against other replacement policies and pool sizes by bufsim
+    const Status startTrace(const string& fileName);
+    const Status stopTrace();  // finish the trace, if any
+
     const BufStats& getBufStats() const  // get buffer pool usage
     {
         return bufStats;
     }
     const void clearBufStats() { bufStats.clear(); }
+
+    // a scan passed over a page without reading it
+    void countSkipped() { bufStats.skipped++; }
 };
 
 #endif
@@ -0,0 +1,59 @@
+#ifndef BUFTRACE_H
+#define BUFTRACE_H
+
+#include <stdio.h>
+
+#include <map>
+#include <string>
+
+#include "error.h"
+
+using namespace std;
+
+class File;
+struct FileMetrics;
+
+// Buffer pool events recorded in a trace.
+enum TraceOp {
+    TRACE_FILE,    // names a file: pageNo holds the length of the name,
+                   // which follows the record
+    TRACE_READ,    // BufMgr::readPage
+    TRACE_ALLOC,   // BufMgr::allocPage
+    TRACE_UNPIN,   // BufMgr::unPinPage
+    TRACE_DISPOSE  // BufMgr::disposePage
+};
+
+// flags of a trace record
+const int TRACE_HIT = 1;    // read found the page in the pool
+const int TRACE_DIRTY = 2;  // unpin marked the page dirty
+
+// One event of a buffer trace. A trace file is a sequence of these, in
+// the byte order of the machine that wrote it; files are numbered in the
+// order they first appear, each announced by a TRACE_FILE record.
+struct TraceRec {
+    unsigned char op;       // a TraceOp
+    unsigned char flags;    // TRACE_HIT, TRACE_DIRTY
+    unsigned short fileId;  // file of the page
+    int pageNo;             // page within the file
+    int pinCnt;             // pin count of the page after the event
+};
+
+// Writes a trace of buffer pool accesses, see BufMgr::startTrace().
+
+class BufTrace {
+   public:
+    BufTrace() : fp(NULL) {}
+    ~BufTrace() { close(); }
+
+    const Status open(const string& fileName);
+    const Status close();
+
+    void record(const TraceOp op, const File* file, const int pageNo,
+                const int pinCnt, const int flags);
+
+   private:
+    FILE* fp;                              // trace file
+    map<const FileMetrics*, int> fileIds;  // numbers of files seen so far
+};
+
+#endif
@@ -11,6 +11,11 @@
 #define MAXNAME 32             // length of relName, attrName
 #define MAXSTRINGLEN 255       // max. length of string attribute
 
+// attribute flags
+#define ATTRVARLEN 1   // varchar: a string stored without its padding
+#define ATTRDICT 2     // a string stored as its code in a dictionary
+#define ATTRCLUSTER 4  // the relation was last clustered on it
+
 // schema of relation catalog:
 //   relation name : char(32)           <-- lookup key
 //   attribute count : integer(4)
@@ -42,9 +47,11 @@ class RelCatalog : public HeapFile {
     // remove tuple from catalog
     const Status removeInfo(const string& relation);
 
-    // create a new relation
+    // create a new relation; attrFlags, if given, holds the flags of
+    // each attribute
     const Status createRel(const string& relation, const int attrCnt,
-                           const attrInfo attrList[]);
+                           const attrInfo attrList[],
+                           const int attrFlags[] = NULL);
 
     // destroy a relation
     const Status destroyRel(const string& relation);
@@ -62,6 +69,7 @@ class RelCatalog : public HeapFile {
 //   attribute number : integer(4)
 //   attribute type : integer(4)  (type is Datatype actually)
 //   attribute size : integer(4)
+//   attribute flags : integer(4)
 
 typedef struct {
     char relName[MAXNAME];   // relation name
@@ -69,6 +77,7 @@ typedef struct {
     int attrOffset;          // attribute offset
     int attrType;            // attribute type
     int attrLen;             // attribute length
+    int attrFlags;           // ATTRVARLEN, ATTRDICT, ATTRCLUSTER
 } AttrDesc;
 
 class AttrCatalog : public HeapFile {
@@ -88,6 +97,10 @@ class AttrCatalog : public HeapFile {
     // remove tuple from catalog
     const Status removeInfo(const string& relation, const string& attrName);
 
+    // set the flags of an attribute
+    const Status setFlags(const string& relation, const string& attrName,
+                          const int flags);
+
     // get all attributes of a relation
     const Status getRelInfo(const string& relation, int& attrCnt,
                             AttrDesc*& attrs);
@@ -102,7 +115,9 @@ class AttrCatalog : public HeapFile {
 extern RelCatalog* relCat;
 extern AttrCatalog* attrCat;
 extern Error error;
-extern Status createHeapFile(const string filename);
+extern Status createHeapFile(const string filename,
+                             const RecFormat* format = NULL);
 extern Status destroyHeapFile(const string filename);
+extern Status renameHeapFile(const string fromName, const string toName);
 
 #endif
@@ -0,0 +1,119 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Creates a relation of N binary tuples for the bench driver, in the
+ * format read by load:
+ *
+ *   unique1  int       random permutation of 0 .. N-1
+ *   unique2  int       0 .. N-1 in order
+ *   skewed   int       zipf distributed over 0 .. N-1 with parameter skew,
+ *                      value 0 the most frequent (skew 0 is uniform)
+ *   pad      char(52)  filler, so that tuples are 64 bytes
+ *
+ * Data depends only on N, skew and seed, so runs are reproducible.
+ *
+ * usage: create_bench file N [skew [seed]]
+ */
+
+typedef struct {
+  int unique1;
+  int unique2;
+  int skewed;
+  char pad[52];
+} Tuple;
+
+/* cumulative zipf probabilities of the values 0 .. n-1 */
+
+static double *zipf_cdf(int n, double skew)
+{
+  double *cdf, sum = 0;
+  int i;
+
+  if ((cdf = (double*)malloc(n * sizeof(double))) == NULL)
+    return NULL;
+  for (i = 0; i < n; i++)
+    sum += cdf[i] = 1.0 / pow(i + 1.0, skew);
+  for (i = 0; i < n; i++)
+    cdf[i] = (i ? cdf[i - 1] : 0) + cdf[i] / sum;
+  cdf[n - 1] = 1.0;
+  return cdf;
+}
+
+/* value whose cumulative probability first reaches u */
+
+static int zipf_draw(const double *cdf, int n, double u)
+{
+  int lo = 0, hi = n - 1, mid;
+
+  while (lo < hi) {
+    mid = (lo + hi) / 2;
+    if (cdf[mid] < u)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+int main(int argc, char **argv)
+{
+  FILE *fp;
+  Tuple t;
+  double skew = 0, *cdf;
+  int n, i, j, tmp, *perm;
+  unsigned int seed = 1;
+
+  if (argc < 3 || (n = atoi(argv[2])) <= 0) {
+    fprintf(stderr, "usage: %s file N [skew [seed]]\n", argv[0]);
+    return 1;
+  }
+  if (argc > 3)
+    skew = atof(argv[3]);
+  if (argc > 4)
+    seed = (unsigned int)atoi(argv[4]);
+  if (skew < 0) {
+    fprintf(stderr, "skew must not be negative\n");
+    return 1;
+  }
+
+  perm = (int*)malloc(n * sizeof(int));
+  cdf = zipf_cdf(n, skew);
+  if (perm == NULL || cdf == NULL) {
+    fprintf(stderr, "out of memory\n");
+    return 1;
+  }
+
+  srand(seed);
+  for (i = 0; i < n; i++)
+    perm[i] = i;
+  for (i = n - 1; i > 0; i--) {
+    j = rand() % (i + 1);
+    tmp = perm[i];
+    perm[i] = perm[j];
+    perm[j] = tmp;
+  }
+
+  if ((fp = fopen(argv[1], "wb")) == NULL) {
+    perror(argv[1]);
+    return 1;
+  }
+  memset(&t, 0, sizeof(t));
+  memset(t.pad, 'x', sizeof(t.pad) - 1);
+  for (i = 0; i < n; i++) {
+    t.unique1 = perm[i];
+    t.unique2 = i;
+    t.skewed = zipf_draw(cdf, n, (rand() + 0.5) / ((double)RAND_MAX + 1));
+    if (fwrite((void*)&t, sizeof(t), 1, fp) < 1) {
+      fprintf(stderr, "Error in creating file\n");
+      return 1;
+    }
+  }
+  fclose(fp);
+
+  free(perm);
+  free(cdf);
+  return 0;
+}
@@ -0,0 +1,56 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Creates unique1_<N>_R.data and unique1_<N>_S.data, each holding a random
+ * permutation of the integers 0 .. N-1 as binary tuples of one int, so
+ * that R.unique1 = S.unique1 produces exactly N result tuples.
+ *
+ * usage: create_unique1 N
+ */
+
+static void create(const char *name, int n, int *vals)
+{
+  FILE *fp;
+  int i, j, tmp;
+
+  for (i = 0; i < n; i++)
+    vals[i] = i;
+  for (i = n - 1; i > 0; i--) {
+    j = rand() % (i + 1);
+    tmp = vals[i];
+    vals[i] = vals[j];
+    vals[j] = tmp;
+  }
+
+  if ((fp = fopen(name, "wb")) == NULL) {
+    perror(name);
+    exit(1);
+  }
+  if (fwrite((void*)vals, sizeof(int), n, fp) < (size_t)n)
+    fprintf(stderr, "Error in creating file\n");
+  fclose(fp);
+}
+
+int main(int argc, char **argv)
+{
+  char name[64];
+  int n, *vals;
+
+  if (argc < 2 || (n = atoi(argv[1])) <= 0) {
+    fprintf(stderr, "usage: %s N\n", argv[0]);
+    return 1;
+  }
+  if ((vals = (int*)malloc(n * sizeof(int))) == NULL) {
+    fprintf(stderr, "out of memory\n");
+    return 1;
+  }
+
+  sprintf(name, "unique1_%d_R.data", n);
+  create(name, n, vals);
+  sprintf(name, "unique1_%d_S.data", n);
+  create(name, n, vals);
+
+  free(vals);
+  return 0;
+}
@@ -5,8 +5,11 @@
 #include <sys/types.h>
 
 #include <functional>
+#include <utility>
+#include <vector>
 
 #include "error.h"
+#include "metrics.h"
 using namespace std;
 
 // define if debug output wanted
@@ -16,6 +19,8 @@ using namespace std;
 
 // forward class definition for db
 class DB;
+class Page;
+struct IORequest;
 
 // class definition for open files
 class File {
@@ -32,6 +37,24 @@ class File {
     const Status getFirstPage(
         int& pageNo) const;  // returns pageNo of first page
 
+    // set up req to read or write page pageNo from/to pagePtr
+    void prepIO(IORequest& req, const int pageNo, Page* pagePtr,
+                const bool write) const;
+
+    // stop using O_DIRECT, e.g. when the file system rejects the page
+    // size or alignment
+    const Status clearDirect();
+    bool isDirect() const { return direct; }
+
+    // pointer to page pageNo of a mapped file (read only)
+    const Status mappedPage(const int pageNo, const Page*& page);
+    bool isMapped() const { return mapAddr != NULL; }
+
+    // buffer pool and I/O counters of the file
+    FileMetrics* getMetrics() const { return stats; }
+
+    const string& getName() const { return fileName; }
+
     bool operator==(const File& other) const {
         return fileName == other.fileName;
     }
@@ -46,6 +69,12 @@ class File {
     const Status open();
     const Status close();
 
+    // reserve cnt zeroed pages starting at pageNo
+    const Status extend(const int pageNo, const int cnt);
+
+    const Status map();    // map file into memory, read only
+    const Status unmap();  // remove all mappings of the file
+
     const Status intread(const int pageNo,
                          Page* pagePtr) const;  // internal file read
     const Status intwrite(const int pageNo,
@@ -58,6 +87,14 @@ class File {
     string fileName;  // The name of the file
     int openCnt;      // # times file has been opened
     int unixFile;     // unix file stream for file
+    bool direct;      // file is opened with O_DIRECT
+
+    char* mapAddr;   // start of read-only mapping, NULL if not mapped
+    long mapLen;     // length of address range reserved for mapping
+    long mappedLen;  // file length known to be covered by mapping
+    vector<pair<char*, long> > retiredMaps;  // outgrown mappings
+
+    FileMetrics* stats;  // counters of the file, kept across opens
 };
 
 class BufMgr;
@@ -103,17 +140,41 @@ class DB {
                                                        // release all space
     const Status openFile(const string& fileName, File*& file);  // open a file
     const Status closeFile(File* file);                          // close a file
+    const Status renameFile(const string& fromName,
+                            const string& toName);  // rename a closed file,
+                                                    // replacing toName
+
+    // map an open file for read-only scans
+    const Status mapFile(File* file);
+
+    // files opened while direct I/O is on bypass the OS page cache
+    // (O_DIRECT); only pages in the buffer pool are cached
+    void setDirectIO(const bool on) { directIO = on; }
+    bool getDirectIO() const { return directIO; }
+
+    // read-only scans use mapped files when map mode is on
+    void setMapMode(const bool on) { mapMode = on; }
+    bool getMapMode() const { return mapMode; }
 
    private:
     OpenFileHashTbl openFiles;  // list of open files
+    bool mapMode;               // map files for read-only scans
+    bool directIO;              // open files with O_DIRECT
 };
 
+// Files grow by extents of EXTENTPAGES contiguous pages. New pages are
+// handed out from the current extent in page order, so a file that only
+// grows keeps its pages physically in the order they were allocated.
+const int EXTENTPAGES = 32;
+
 // structure of DB (header) page
 
 typedef struct {
-    int nextFree;   // page # of next page on free list
-    int firstPage;  // page # of first page in file
-    int numPages;   // total # of pages in file
+    int nextFree;    // page # of next page on free list
+    int firstPage;   // page # of first page in file
+    int numPages;    // total # of pages in file
+    int extentNext;  // next unallocated page of the current extent
+    int extentEnd;   // first page past the current extent
 } DBPage;
 
 #endif
@@ -53,6 +53,8 @@ enum Status {
     SCANTABFULL,
     FILEEOF,
     FILEHDRFULL,
+    DICTFULL,
+    BADDICTCODE,
 
     // Index errors
 
@@ -82,10 +84,20 @@ enum Status {
 
     // Utility errors
 
+    BADLOADDATA,
+
     // Query errors
 
     ATTRTYPEMISMATCH,
     TMP_RES_EXISTS,
+    NOTGROUPED,
+
+    // Transaction errors
+
+    LOCKWAIT,
+    DEADLOCK,
+    TXNACTIVE,
+    NOTXN,
 
     // do not touch filler -- add codes before it
 
@@ -0,0 +1,88 @@
+#ifndef EXPLAIN_H
+#define EXPLAIN_H
+
+#include <sys/time.h>
+
+#include <string>
+#include <vector>
+
+#include "buf.h"
+#include "catalog.h"
+
+// An operator of an explained query, as recorded by a PlanStep. Operators
+// are kept in the order they started; depth is the number of operators
+// that were running when this one started.
+struct PlanOp {
+    string name;      // operator, e.g. "HashJoin"
+    string detail;    // what the operator works on
+    int depth;        // nesting below the operator that invoked it
+    double estRows;   // estimated number of output tuples, or -1
+    int rows;         // actual number of output tuples, or -1
+    double secs;      // wall time, including nested operators
+    BufStats bufs;    // buffer pool activity, including nested operators
+};
+
+// The plan of a query being explained. With analyze set the query is run
+// and each operator records its row count, time and buffer pool activity;
+// otherwise operators only describe themselves and return without doing
+// any work.
+
+class QueryPlan {
+   public:
+    QueryPlan(const bool analyze) : analyze(analyze), depth(0) {}
+
+    // print the operators, indented by depth
+    void print() const;
+
+    const bool analyze;  // the query is run
+
+   private:
+    friend class PlanStep;
+    std::vector<PlanOp> ops;  // operators in the order they started
+    int depth;                // number of running operators
+};
+
+// plan of the query being explained, NULL if none is
+extern QueryPlan* queryPlan;
+
+// Records an operator in queryPlan for the lifetime of the step; a no-op
+// when no query is being explained. An operator declares its step once it
+// has chosen its method, returns right away if planOnly() is true, and
+// reports its number of output tuples with setRows().
+
+class PlanStep {
+   public:
+    PlanStep(const char* name,        // operator
+             const string& detail,    // what it works on
+             const double estRows);   // estimated output tuples, or -1
+    ~PlanStep();
+
+    // report the number of output tuples
+    void setRows(const int rows);
+
+    // true if operators should only describe themselves
+    static bool planOnly() { return queryPlan && !queryPlan->analyze; }
+
+    // true if a query is being explained, so that the details and
+    // estimates of steps are used
+    static bool explaining() { return queryPlan != NULL; }
+
+    // number of tuples of relation, or -1 if it cannot be opened; -1
+    // without opening it when no query is being explained
+    static double relRows(const string& relation);
+
+    // estimated fraction of tuples satisfying a comparison with operator
+    // op, using the usual defaults in the absence of attribute statistics
+    static double selectivity(const Operator op);
+
+    // text of the predicate "attr op value", for use in details
+    static string predicate(const AttrDesc& attr, const Operator op,
+                            const char* value);
+
+   private:
+    int index;             // of the operator in queryPlan->ops, or -1
+    struct timeval start;  // when the step started
+    BufStats startStats;   // buffer pool statistics at start
+};
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef HASHJOIN_H
+#define HASHJOIN_H
+
+#include <atomic>
+#include <vector>
+
+#include "catalog.h"
+#include "joinHT.h"
+#include "partition.h"
+#include "project.h"
+
+// define if debug output wanted
+// #define DEBUGHJ
+
+// Target size (in bytes) of the build side of one partition. Partitions
+// this small keep the tuples and their bucket array resident in a per-core
+// cache while the partition is built and probed.
+const int HJ_PARTBYTES = 256 * 1024;
+
+// Upper bound on the number of radix partitions of one input.
+const int HJ_MAXPARTS = 1 << 14;
+
+// In-memory copy of a join input: fixed-length tuples stored back to back
+// in the order they were read (or scattered) into the buffer.
+struct TupleBuf {
+    char* data;  // cnt * reclen bytes
+    int reclen;  // length of each tuple
+    int cnt;     // number of tuples in the buffer
+    int max;     // number of tuples allocated
+
+    TupleBuf() : data(NULL), reclen(0), cnt(0), max(0) {}
+    ~TupleBuf() { free(data); }
+    char* tuple(const int i) const { return data + (long)i * reclen; }
+};
+
+// Parallel radix-partitioned hash join.
+//
+// Both inputs are read into memory and partitioned on the join attribute
+// by all worker threads, using the same hash function hook as the
+// Partition class. The number of partitions is chosen so that the build
+// side of each partition fits in HJ_PARTBYTES. Partition pairs are then
+// built into a joinHashTbl and probed independently by the worker threads,
+// each of which collects the index pairs of its matching tuples. The heap
+// files themselves are read and written by the calling thread only, since
+// the buffer manager is not thread safe; it projects the matching pairs
+// directly into the result pages.
+//
+// If both join attributes are dictionary encoded, the join is on codes
+// instead of strings: each tuple is read with the code of its join
+// attribute appended, codes of relation 2 translated to those of relation
+// 1, and tuples of relation 2 whose value is not in the dictionary of
+// relation 1 are dropped right away.
+
+class RadixHashJoin {
+   public:
+    RadixHashJoin(const AttrDesc& attrDesc1,  // join attribute of relation 1
+                  const AttrDesc& attrDesc2,  // join attribute of relation 2
+                  const int numThreads,       // number of worker threads
+                  Status& status);
+    ~RadixHashJoin();
+
+    // apply scanFilter while reading relation rel (1 or 2)
+    void setScanFilter(const int rel, ScanFilter* scanFilter);
+
+    // number of tuples dropped by the scan filter
+    const int getFilteredCnt() const { return filteredCnt; }
+
+    // join the two relations, writing the projection of every matching
+    // pair to result; resultCnt returns the number of tuples
+    const Status execute(const int projCnt, const AttrDesc projDescs[],
+                         InsertFileScan& result, int& resultCnt);
+
+   private:
+    // read all tuples of relation rel (1 or 2) that pass its scan filter
+    // into buf
+    const Status readInput(const int rel, TupleBuf& buf);
+
+    // translate the codes of dict, the dictionary of relation 2, to those
+    // of relation 1
+    void mapCodes(const AttrDict& dict);
+
+    // partition in into out using hashfcn, which is given the address of
+    // key as its argument; partStart[p] returns the index
+    // of the first tuple of partition p and partStart[P] the tuple count
+    const Status partitionInput(const TupleBuf& in, const AttrDesc& key,
+                                PartHashFcn hashfcn, TupleBuf& out,
+                                std::vector<int>& partStart);
+
+    // build and probe partitions, handed out to workers through nextPart
+    void joinPartitions(const int thread);
+
+    AttrDesc buildAttr;  // join attribute of build (smaller) input
+    AttrDesc probeAttr;  // join attribute of probe input
+    int numThreads;      // number of worker threads
+    int P;               // number of partitions (a power of two)
+
+    ScanFilter* scanFilter[2];  // scan filters of relations 1 and 2
+    int filteredCnt;            // tuples dropped by scan filters
+
+    bool codeJoin;             // join on dictionary codes
+    AttrDict* dict1;           // dictionary of relation 1, if codeJoin
+    std::vector<int> codeMap;  // code in dict1 of each code of relation 2,
+                               // -1 if the value is not in dict1
+
+    TupleBuf buildParts;             // build input, partitioned
+    TupleBuf probeParts;             // probe input, partitioned
+    std::vector<int> buildStart;     // first tuple of each build partition
+    std::vector<int> probeStart;     // first tuple of each probe partition
+    std::atomic<int> nextPart;       // next partition to join
+    std::atomic<bool> failed;        // a worker ran out of memory
+    std::vector<TupleBuf*> results;  // match index pairs of each worker
+};
+
+#endif
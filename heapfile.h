@@ -7,12 +7,14 @@
 
 #include <functional>
 #include <iostream>
+#include <unordered_map>
 #include <vector>
 
 #include "stdlib.h"
 using namespace std;
 
 #include "buf.h"
+#include "lockMgr.h"
 #include "page.h"
 
 extern DB db;
@@ -23,15 +25,142 @@ extern DB db;
 // Some constant definitions
 const unsigned MAXNAMESIZE = 50;
 
+// Number of pages a scan with zone maps reads ahead with an asynchronous
+// I/O engine; other scans only know the next page of the chain.
+const int SCANPREFETCH = 8;
+
 enum Datatype { STRING, INTEGER, FLOAT };    // attribute data types
 enum Operator { LT, LTE, EQ, GTE, GT, NE };  // scan operators
 
+// Most files store their records as they are. The records of a relation
+// with varchar or dictionary encoded attributes are stored packed instead:
+// a table of the end offsets of the varchar attributes (one short each),
+// the other attributes, and then the varchar attributes without the
+// padding after their string. A dictionary encoded attribute is stored as
+// the code of its value in the dictionary of the attribute, which is kept
+// on dictionary pages of the file. Records are unpacked to their full
+// length when read, so everything above the heap file sees the fixed
+// layout.
+const int MAXVARATTRS = 32;
+const int MAXDICTATTRS = 16;
+
+typedef unsigned short DictCode;   // code of a dictionary value
+const int MAXDICTCODES = 1 << 16;  // values in one dictionary
+
+struct VarAttr {
+    short offset;  // offset of the attribute in the unpacked record
+    short length;  // its length there
+};
+
+struct DictAttr {
+    short offset;   // offset of the attribute in the unpacked record
+    short length;   // its length there
+    int valueCnt;   // number of values in the dictionary
+    int firstPage;  // first dictionary page, -1 if there is none yet
+    int lastPage;   // last dictionary page
+};
+
+// Zone maps: the file keeps the smallest and the largest value of its
+// first MAXZONEATTRS numeric attributes for each data page, so that a scan
+// with a range or equality filter can pass over the pages that cannot
+// hold a match without reading them. The summaries are the records of
+// zone map pages chained from the header, one per data page in the order
+// of the page chain. Deleting a record leaves the summary of its page as
+// it is, so a summary may be wider than the records of its page but never
+// narrower; vacuum makes them exact again.
+const int MAXZONEATTRS = 8;
+
+struct ZoneAttr {
+    short offset;  // offset of the attribute in the unpacked record
+    short type;    // INTEGER or FLOAT
+};
+
+// The summary of a data page. An entry is stored with the bounds of the
+// attributes of its file only; a page that never had a record has none.
+struct ZoneEntry {
+    int pageNo;                                  // the data page
+    int recCnt;                                  // records added to it
+    char bounds[2 * MAXZONEATTRS][sizeof(int)];  // min and max per attribute
+};
+
+// The attribute the records of a clustered file are in order of, as
+// written by a rewrite that sorted them. Adding a record ends the order.
+struct ClusterAttr {
+    short offset;  // offset of the attribute, -1 if the file is not in order
+    short length;  // its length
+    short type;    // its type
+};
+
+// Multi-version records: every record of a relation is stamped with the
+// transaction that added it and the one that deleted it, right after the
+// record as stored, so that offsets into stored records stay as they
+// are. A delete in a transaction only stamps the record, which scans
+// still return to the transactions that do not see the delete (see
+// Snapshot); scans that only read take no locks, so they do not wait for
+// the transactions of other sessions (statements themselves still run one
+// at a time, see Server). Vacuum removes records once their delete has
+// committed. A stamp of 0 is no transaction: the record was added outside
+// of one, or is seen by all since vacuum.
+struct RecStamp {
+    int xmin;  // transaction that added the record
+    int xmax;  // transaction that deleted it, 0 if none
+};
+
+struct RecFormat {
+    int recLen;                   // unpacked record length; 0 if not packed
+    int varCnt;                   // number of varchar attributes
+    VarAttr var[MAXVARATTRS];     // varchar attributes, by offset
+    int dictCnt;                  // number of dictionary encoded attributes
+    DictAttr dict[MAXDICTATTRS];  // dictionary encoded attributes, by offset
+    int zoneCnt;                  // number of attributes with zone maps
+    ZoneAttr zone[MAXZONEATTRS];  // those attributes, by offset
+    int zoneEntries;              // number of zone map entries
+    int zoneFirstPage;            // first zone map page, -1 if none
+    int zoneLastPage;             // last zone map page
+    RID zoneLast;                 // entry of the last data page
+    ClusterAttr cluster;          // attribute the records are in order of
+    int versioned;                // records end with a RecStamp
+};
+
+// The dictionary of an encoded attribute, read into memory when the file
+// is opened. Value i of the dictionary has code i. Values are kept padded
+// with nulls to the length of the attribute; two values are the same if
+// they agree up to their first null.
+class AttrDict {
+   public:
+    AttrDict(const int length, const int pos) : length(length), pos(pos) {}
+
+    // code of value, or -1 if it is not in the dictionary
+    const int lookup(const char* value) const;
+
+    // add value, which is not in the dictionary yet, returning its code
+    const int add(const char* value);
+
+    // the value with code code
+    const char* value(const int code) const {
+        return &values[(long)code * length];
+    }
+
+    // number of values, length of a value, and offset of the code in a
+    // packed record
+    int count() const { return values.size() / length; }
+    int getLength() const { return length; }
+    int getPos() const { return pos; }
+
+   private:
+    int length;                        // length of the attribute
+    int pos;                           // offset of the code
+    vector<char> values;               // the values, in code order
+    unordered_map<string, int> codes;  // code of each value
+};
+
 struct FileHdrPage {
     char fileName[MAXNAMESIZE];  // name of file
     int firstPage;               // pageNo of first data page in file
     int lastPage;                // pageNo of last data page in file
     int pageCnt;                 // number of pages
     int recCnt;                  // record count
+    RecFormat format;            // how records are stored
 };
 
 // class definition of heapFile
@@ -47,6 +176,25 @@ class HeapFile {
     bool curDirtyFlag;  // true if page has been updated
     RID curRec;         // rid of last record returned
 
+    char* recBuf;  // last record unpacked, if records are packed
+
+    vector<AttrDict> dicts;  // dictionaries of the encoded attributes
+    vector<int> zonePos;     // offset of each zone map attribute in a
+                             // stored record
+
+    // take the stamp off the stored record rec, and unpack it into recBuf
+    // if records are packed
+    const Status unpack(Record& rec);
+
+    // length of the stamp of a stored record, 0 if they have none
+    const int stampLen() const {
+        return headerPage->format.versioned ? sizeof(RecStamp) : 0;
+    }
+
+    // read the values of the dictionaries that are not in memory yet
+    const Status readDicts();
+    const Status syncDicts();  // same, if there are any
+
    public:
     // initialize
     HeapFile(const string& name, Status& returnStatus);
@@ -57,13 +205,78 @@ class HeapFile {
     // return number of records in file
     const int getRecCnt() const;
 
+    // how the records of the file are stored
+    const RecFormat& getFormat() const { return headerPage->format; }
+
+    // dictionary of the attribute at offset, NULL if it is not encoded
+    const AttrDict* getDict(const int offset) const;
+
+    // record that the records are in order of attribute cluster, until a
+    // record is added
+    void setCluster(const ClusterAttr& cluster);
+
     // given a RID, read record from file, returning pointer and length
     const Status getRecord(const RID& rid, Record& rec);
+
+    // remove the records whose delete has committed, compact all data
+    // pages and dispose of empty ones, returning the number of records
+    // removed and of pages given back to the file
+    const Status vacuum(int& deadCnt, int& freedCnt);
+
+    // take back the insert of record rid, put back record rec (as stored)
+    // at rid, where it was deleted from, or take the stamp of a delete off
+    // record rid; for rolling back
+    const Status removeRecord(const RID& rid);
+    const Status restoreRecord(const RID& rid, const Record& rec);
+    const Status reviveRecord(const RID& rid);
+};
+
+// Extra predicate a HeapFileScan can apply to each record on top of the
+// filter given to startScan, e.g. a semi-join filter supplied by a join.
+class ScanFilter {
+   public:
+    virtual ~ScanFilter() {}
+
+    // true if the record should be returned by the scan
+    virtual bool match(const Record& rec) = 0;
 };
 
+// ScanFilter comparing an attribute with a constant, like the filter given
+// to HeapFileScan::startScan; for scans that cannot take that filter, such
+// as the one a SortedFile reads its input with.
+class AttrFilter : public ScanFilter {
+   public:
+    AttrFilter(const int offset, const int length, const Datatype type,
+               const char* filter, const Operator op);
+
+    bool match(const Record& rec);
+
+   private:
+    int offset;          // byte offset of filter attribute
+    int length;          // length of filter attribute
+    Datatype type;       // datatype of filter attribute
+    const char* filter;  // comparison value of filter, NULL for none
+    Operator op;         // comparison operator of filter
+};
+
+// compare attribute values p1 and p2 of the given type and length; returns
+// a value less than, equal to or greater than 0 if p1 is less than, equal
+// to or greater than p2
+const int compareAttr(const char* p1, const char* p2, const int length,
+                      const Datatype type);
+
+// true if attribute value attr and filter satisfy op
+const bool matchAttr(const char* attr, const char* filter, const int length,
+                     const Datatype type, const Operator op);
+
 class HeapFileScan : public HeapFile {
    public:
-    HeapFileScan(const string& name, Status& status);
+    // A read-only scan never deletes or updates records, and takes no
+    // locks on a file of multi-version records. If the database is in
+    // map mode (see DB::setMapMode), it reads pages directly from the
+    // memory mapped file instead of through the buffer pool.
+    HeapFileScan(const string& name, Status& status,
+                 const bool readOnly = false);
 
     // end filtered scan
     ~HeapFileScan();
@@ -82,12 +295,30 @@ class HeapFileScan : public HeapFile {
     // read current record, returning pointer and length
     const Status getRecord(Record& rec);
 
+    // code of the dictionary encoded attribute at offset in the current
+    // record, read without unpacking the record
+    const Status getCode(const int offset, int& code);
+
     // delete current record
     const Status deleteRecord();
 
     // marks current page of scan dirty
     const Status markDirty();
 
+    // apply scanFilter (NULL for none) to records that satisfy the scan's
+    // filter; remains in effect across calls to startScan()
+    void setScanFilter(ScanFilter* scanFilter);
+
+    // number of records rejected by the scan filter
+    const int getFilteredCnt() const { return filteredCnt; }
+
+    // Let startScan() start the scan at the page other scans of the file
+    // in progress are on (see SS_Join), so that it finds the pages they
+    // read in the buffer pool; it wraps around to the first page for the
+    // pages it missed, so records come in no particular order. Scans the
+    // zone maps or the order of the records end early do not share.
+    void shareScan() { sharing = true; }
+
    private:
     int offset;          // byte offset of filter attribute
     int length;          // length of filter attribute
@@ -95,14 +326,71 @@ class HeapFileScan : public HeapFile {
     const char* filter;  // comparison value of filter
     Operator op;         // comparison operator of filter
 
+    int filterCode;  // code of filter, if compared as a code; -1 if the
+                     // filter is not in the dictionary
+    int codePos;     // offset of that code when packed; -1 if the filter
+                     // is not compared as a code
+
+    vector<int> zonePages;  // with a filter the zone maps apply to, the
+                            // data pages in chain order when the scan
+                            // started, -1 for those that cannot match
+    int zoneIdx;            // position of the current page in the chain
+
+    bool rangeEnd;  // the records are in order of the filter attribute, so
+                    // the scan ends at the first record past the filter
+
+    ScanFilter* scanFilter;  // extra predicate, NULL if none
+    int filteredCnt;         // records rejected by scanFilter
+
+    bool mapped;  // pages come from the mapped file, not the buffer pool
+
+    bool locking;       // pages are locked before they are read
+    Snapshot snapshot;  // transactions whose records the scan returns
+
+    bool sharing;     // the scan may join other scans of the file
+    bool joined;      // it has joined them, and leaves them at endScan()
+    int startPageNo;  // page it started at, -1 for the first page
+    bool wrapped;     // it went on at the first page after the last one
+
     // The following variables are used to preserve the state
     // of the scan when the method markScan() is invoked.
     // A subsequent invocation of resetScan() will cause the
     // scan to be rolled back to the following
-    int markedPageNo;  // page number of pinned page
-    RID markedRec;     // rid of last record returned
+    int markedPageNo;    // page number of pinned page
+    RID markedRec;       // rid of last record returned
+    int markedZoneIdx;   // position of that page in the chain
+    bool markedWrapped;  // whether the scan had wrapped around by then
 
     const bool matchRec(const Record& rec) const;
+
+    // the filter attribute of stored record rec, copied to buf if it has
+    // to be padded out; NULL if the record is too short
+    const char* filterAttr(const Record& rec, char* buf) const;
+
+    // true if no record after rec can satisfy the filter
+    const bool pastRange(const Record& rec) const;
+    const Status endRange();  // end the scan there
+
+    // true if rec satisfies both the filter and the scan filter
+    const bool matchFilters(const Record& rec);
+
+    // true if stored record rec is seen in the snapshot; its stamp is
+    // taken off rec
+    const bool visible(Record& rec) const;
+
+    // read the zone maps of the file, for filter attribute k
+    const Status readZones(const int k);
+
+    // join the scans of the file in progress, if the scan may share
+    const Status joinScans();
+
+    // the first page from chain position idx on that may hold a match,
+    // page pageNo being at that position; -1 if there is none
+    const int zoneSkip(const int idx, const int pageNo);
+
+    // make page pageNo the current page, or release the current page
+    const Status readScanPage(const int pageNo);
+    const Status releaseScanPage();
 };
 
 class InsertFileScan : public HeapFile {
@@ -114,6 +402,37 @@ class InsertFileScan : public HeapFile {
 
     // insert record into file, returning its RID
     const Status insertRecord(const Record& rec, RID& outRid);
+
+    // add a record of length bytes to the file without copying it in,
+    // returning its RID and a pointer to its data on the page. The caller
+    // fills in the data before the next call on this scan. If records are
+    // packed, the record is packed in place at the next call, which also
+    // adds it to the zone maps.
+    const Status reserveRecord(const int length, RID& outRid, char*& recPtr);
+
+   private:
+    RID reserved;    // record reserved but not yet finished, or NULLRID
+    RID curZone;     // zone map entry of the current page
+    Page* zonePage;  // zone map page of that entry, if pinned
+
+    // pack the reserved record and add it to the zone maps
+    const Status finishReserved();
+
+    // widen the zone map entry of the current page to stored record rec
+    const Status updateZone(const char* rec);
+
+    // make zoneRid the zone map entry of the current page
+    const Status setZone(const RID& zoneRid);
+
+    // pack record rec into out, adding values that are not in the
+    // dictionaries yet; length returns the packed length
+    const Status pack(const char* rec, char* out, int& length);
+
+    // add value to the dictionary pages of dictionary k
+    const Status addDictValue(const int k, const char* value);
+
+    // space for a record of length bytes as stored
+    const Status allocRecord(const int length, RID& outRid, char*& recPtr);
 };
 
 #endif
@@ -0,0 +1,43 @@
+#ifndef INSERT_H
+#define INSERT_H
+
+#include <vector>
+
+#include "catalog.h"
+#include "heapfile.h"
+
+// Batch inserter: inserts any number of tuples into one relation. The
+// schema is looked up and the attributes of the insert are matched to
+// it once, and all tuples go through one InsertFileScan, which keeps the
+// last page of the file pinned, so a page is pinned once for all tuples
+// that fit on it. Each tuple is built in place on that page.
+
+class BatchInserter {
+   public:
+    // match the attributes of attrList (names and types; the values are
+    // not used) to the schema of relation, which they must cover exactly
+    BatchInserter(const string& relation, const int attrCnt,
+                  const attrInfo attrList[], Status& status);
+    ~BatchInserter();
+
+    // insert a tuple; attrList has the attributes given to the
+    // constructor, in the same order
+    const Status insert(const attrInfo attrList[]);
+
+    // number of tuples inserted
+    int getInsertCnt() const { return insertCnt; }
+
+   private:
+    struct InsAttr {
+        int type;    // attribute type
+        int offset;  // offset in the tuple
+        int len;     // length in the tuple
+    };
+
+    InsertFileScan* ifs;    // open scan on the relation
+    vector<InsAttr> attrs;  // schema attribute of each insert attribute
+    int recSize;            // length of a tuple
+    int insertCnt;          // tuples inserted
+};
+
+#endif
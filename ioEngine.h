@@ -0,0 +1,109 @@
+#ifndef IOENGINE_H
+#define IOENGINE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "error.h"
+
+// define if debug output wanted
+// #define DEBUGIOE
+
+// Alignment of buffers, offsets and lengths of files opened with O_DIRECT.
+const int DIRECTALIGN = 4096;
+
+// An asynchronous page read or write. The submitter owns the request and
+// must not touch it or its buffer until it has been returned by wait().
+struct IORequest {
+    int fd;       // unix file descriptor
+    bool write;   // write (true) or read (false)
+    long offset;  // file offset
+    char* buf;    // data buffer
+    int len;      // number of bytes
+    int result;   // bytes transferred, or -errno
+    void* tag;    // for use by the submitter
+};
+
+// Asynchronous I/O engine. Requests are submitted without waiting for
+// them; completed requests are collected, in any order, with wait().
+
+class IOEngine {
+   public:
+    virtual ~IOEngine() {}
+
+    // start req; with more set, the engine may hold the request back
+    // until the next submit without more (or the next wait) so that a
+    // batch of requests is handed to the kernel at once
+    virtual const Status submit(IORequest* req, const bool more = false) = 0;
+
+    // hand requests held back by submit(..., true) to the kernel
+    virtual const Status flush() { return OK; }
+
+    // wait for some submitted request to complete and return it; returns
+    // NOMORERECS if no requests are in flight
+    virtual const Status wait(IORequest*& done) = 0;
+
+    // number of submitted requests not yet returned by wait()
+    int inFlight() const { return pending; }
+
+    // name of the backend
+    virtual const char* name() const = 0;
+
+    // create the best available engine for up to depth requests in flight:
+    // io_uring if compiled in (HAVE_LIBURING) and supported by the kernel,
+    // else a pool of threads doing pread/pwrite
+    static IOEngine* create(const int depth, const int threads = 4);
+
+   protected:
+    IOEngine() : pending(0) {}
+    int pending;  // requests in flight
+};
+
+// Fallback engine: a pool of threads performing blocking pread/pwrite.
+
+class ThreadPoolEngine : public IOEngine {
+   public:
+    ThreadPoolEngine(const int threads);
+    ~ThreadPoolEngine();
+
+    const Status submit(IORequest* req, const bool more = false);
+    const Status wait(IORequest*& done);
+    const char* name() const { return "threads"; }
+
+   private:
+    void worker();
+
+    std::vector<std::thread> workers;
+    std::mutex lock;                   // protects the queues and shutdown
+    std::condition_variable queued;    // signalled on submit
+    std::condition_variable finished;  // signalled on completion
+    std::deque<IORequest*> submitted;  // waiting for a worker
+    std::deque<IORequest*> completed;  // waiting for wait()
+    bool shutdown;
+};
+
+#ifdef HAVE_LIBURING
+#include <liburing.h>
+
+// io_uring engine; requests go straight to the kernel's submission ring.
+
+class UringEngine : public IOEngine {
+   public:
+    UringEngine(const int depth, Status& status);
+    ~UringEngine();
+
+    const Status submit(IORequest* req, const bool more = false);
+    const Status wait(IORequest*& done);
+    const Status flush();
+    const char* name() const { return "io_uring"; }
+
+   private:
+    struct io_uring ring;
+    int unsubmitted;  // requests queued in the ring but not yet submitted
+};
+#endif
+
+#endif
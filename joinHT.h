@@ -1,36 +1,106 @@
+#ifndef JOINHT_H
+#define JOINHT_H
+
+#include <vector>
+
+#include "bloom.h"
+#include "catalog.h"
+
+// define if debug output wanted
+// #define DEBUGJHT
+
+// Join hash table: maps join attribute values to the (RID, tuple) pairs of
+// the build relation, or to the (index, tuple) pairs of build tuples held
+// in memory (see insertIndex).
+//
+// The table uses open addressing with linear probing. Each slot holds only
+// the hash value and an entry number, so a probe walks a short run of
+// adjacent 8-byte slots and compares full keys only when the hash values
+// agree. The entries themselves (RID followed by the tuple, or by just the
+// join attribute if no tuple length is given) are stored back to back in a
+// single arena. The results of a lookup are collected in a buffer owned by
+// the table that is reused by the next lookup.
 
 class joinHashTbl {
    private:
-    union JAttrType {
-        int iValue;
-        float fValue;
-        char* sValue;
+    struct HTslot {
+        unsigned int hash;  // hash value of key
+        int entry;          // entry number in arena, -1 if slot is empty
     };
 
-    struct joinhashBucket {
-        union JAttrType attrValue;
-        RID rid;
-        joinhashBucket* next;  // next node in the hash table
-    };
+    AttrDesc joinAttr;  // join attribute of the stored tuples
+    int storeOffset;    // offset of the stored part of the tuple
+    int storeLen;       // number of bytes of the tuple stored
+    int keyOffset;      // offset of the join attribute in an arena entry
+    int entryLen;       // length of an arena entry (RID + stored bytes)
 
-    struct HTentry {
-        int bucketCnt;          // nuumber of buckets on this chain
-        joinhashBucket* chain;  // pointer to first bucket on the chain
-    };
+    int logSize;    // table has 2^logSize slots
+    HTslot* slots;  // the slots
+    int entryCnt;   // number of entries
+
+    char* arena;   // entries, entryLen bytes each
+    int arenaMax;  // number of entries allocated in arena
+
+    BloomFilter* bloom;  // filter on hash values, NULL if not used
 
-    AttrDesc joinAttr;
-    int HTSIZE;
-    HTentry* ht;  // actual hash table
-    int hash(const char* attr,
-             int attrType);  // returns value between 0 and HTSIZE-1
+    std::vector<const char*> matches;  // entries found by last lookup
+
+    unsigned int slotOf(const unsigned int h) const {
+        return (h * 0x9E3779B1u) >> (32 - logSize);
+    }
+    char* entryPtr(const int entry) const {
+        return arena + (long)entry * entryLen;
+    }
+    const Status grow();  // double the number of slots
 
    public:
-    joinHashTbl(const int size, const AttrDesc attr);  // constructor
+    joinHashTbl(const int size,                // expected number of tuples
+                const AttrDesc& attr,          // join attribute
+                Status& status,                // HASHTBLERROR if no memory
+                const int tupleLen = 0,        // tuple length, 0: key only
+                const bool useBloom = false);  // pre-check probes with bloom
     ~joinHashTbl();
 
-    // insert a new (JoinAttrValue, RID) pair into hash table
-    Status insert(const RID newRid, const char* tuple);
+    // insert a new (RID, tuple) pair into hash table
+    const Status insert(const RID& newRid, const char* tuple);
+    // same, with hash value h of the tuple's join attribute already known
+    const Status insert(const unsigned int h, const RID& newRid,
+                        const char* tuple);
+    // insert tuple number index of an array of tuples that are not in a
+    // heap file; the index is kept in place of a RID (see matchIndex)
+    const Status insertIndex(const int index, const char* tuple);
+
+    // find the entries whose join attribute matches the value at keyPtr,
+    // an attribute described by keyAttr; matchCnt returns the number found
+    const Status lookup(const char* keyPtr, const AttrDesc& keyAttr,
+                        int& matchCnt);
+    // same, with hash value h of the key already known
+    const Status lookup(const unsigned int h, const char* keyPtr,
+                        const AttrDesc& keyAttr, int& matchCnt);
+
+    // RID and stored tuple (or key) of the i-th match of the last lookup
+    const RID& matchRid(const int i) const {
+        return *(const RID*)matches[i];
+    }
+    const char* matchTuple(const int i) const {
+        return matches[i] + sizeof(RID);
+    }
+    // index of the i-th match of the last lookup, if inserted by
+    // insertIndex
+    const int matchIndex(const int i) const { return matchRid(i).pageNo; }
+
+    // number of entries in the table
+    int count() const { return entryCnt; }
 
-    // get RIDs of records whose join attribute value matches innerJoinAttrValue
-    Status lookup(const char* innerJoinAttrPtr, int& ridCount, RID*& outRids);
+    // remove all entries, keeping the allocated memory for reuse
+    void clear();
 };
+
+// hash value of the join attribute at attrPtr
+unsigned int JHT_hash(const char* attrPtr, const AttrDesc& attr);
+
+// true if the join attribute values at p1 and p2 are equal
+bool JHT_keyEqual(const char* p1, const AttrDesc& attr1, const char* p2,
+                  const AttrDesc& attr2);
+
+#endif
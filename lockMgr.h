@@ -0,0 +1,148 @@
+// lockMgr.h — Lock Manager and Transactions
+// Declares the transactions of sessions, the locks they take on relations
+// and pages, and their undo logs.
+
+#ifndef LOCKMGR_H
+#define LOCKMGR_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "error.h"
+#include "page.h"
+
+using namespace std;
+
+// define if debug output wanted
+// #define DEBUGLOCK
+
+// Lock modes, weakest first. A transaction locks a page of a relation S
+// to read it and X to change it, after taking an intention lock (IS or
+// IX) on the relation; a relation lock of S, SIX or X covers the pages.
+enum LockMode { LK_NONE, LK_IS, LK_IX, LK_S, LK_SIX, LK_X };
+
+// Number of partitions of the lock table. The locks of a relation are all
+// in the partition its name hashes to, which has a latch of its own, so
+// transactions working on different relations rarely meet.
+const int LOCKPARTS = 16;
+
+// Number of page locks a transaction holds on a relation before it tries
+// to lock the whole relation instead; it tries again after as many more
+// if other transactions are in the way.
+const int LOCKESCALATE = 32;
+
+struct LockHead;
+
+// The locks a transaction holds on a relation and its pages.
+struct RelLocks {
+    LockMode mode;             // on the relation, LK_NONE if none
+    map<int, LockMode> pages;  // on its pages, by page number
+    int escalateAt;            // number of page locks to escalate at
+};
+
+// Number of transaction ids reserved in XIDFILE at a time.
+const int XIDBATCH = 1024;
+
+// File of a database holding the first transaction id not handed out yet,
+// so that the ids stamped on records (see RecStamp) are never handed out
+// again by a later run. Relation names cannot start with a dot.
+#define XIDFILE ".xids"
+
+// A change to undo if the transaction aborts: the insert of record rid,
+// the delete of record rid, as it was stored, or the stamp a delete put
+// on record rid of a relation with multi-version records.
+struct UndoEntry {
+    string relation;
+    RID rid;
+    bool stamped;   // the delete only stamped the record
+    string before;  // the record deleted; empty for an insert
+};
+
+// A transaction. It holds every lock it gets until it commits or aborts
+// (strict two-phase locking), and keeps the undo log of its changes to
+// relations; changes to the catalogs, and so creating and destroying
+// relations, are not part of it.
+struct Transaction {
+    int id;
+    bool begun;       // begun by begin, rather than for one statement
+    bool deadlocked;  // chosen as the victim of a deadlock
+    map<string, RelLocks> locks;  // locks held, by relation
+    vector<UndoEntry> undo;       // changes made, oldest first
+
+    // the lock the transaction waits for, if it does
+    LockHead* waitHead;  // NULL if none
+    string waitRel;      // its relation and page (-1 for the relation)
+    int waitPage;
+    LockMode waitMode;  // mode it is to be held in once granted
+};
+
+// The transactions whose changes a scan sees: those that had committed
+// when it was taken, and its own. An aborted transaction leaves no stamps
+// behind, so those that are not running are the committed ones.
+struct Snapshot {
+    int xid;             // transaction taking it, 0 if none
+    int horizon;         // transactions from this id on began later
+    vector<int> active;  // others running when it was taken, in order
+};
+
+// The transaction of the session this thread runs statements for, NULL if
+// there is none; nothing is locked or logged then (e.g. by the tools).
+extern thread_local Transaction* curTxn;
+
+// Start a transaction; begun is set for one started by begin.
+Transaction* TX_Begin(const bool begun);
+
+// Release the locks of txn and end it.
+const Status TX_Commit(Transaction* txn);
+
+// Undo the changes of txn, release its locks and end it.
+const Status TX_Abort(Transaction* txn);
+
+// Position in the undo log of txn, for TX_Rollback.
+const int TX_Savepoint(const Transaction* txn);
+
+// Undo the changes txn made after savepoint; its locks are kept.
+const Status TX_Rollback(Transaction* txn, const int savepoint);
+
+// Take a snapshot for curTxn.
+void TX_Snapshot(Snapshot& snap);
+
+// true if a record stamped by transactions xmin and xmax (0 for none) is
+// seen in snap
+const bool TX_Visible(const Snapshot& snap, const int xmin, const int xmax);
+
+// true if transaction xid (not 0) is still running
+const bool TX_Running(const int xid);
+
+// Lock page pageNo of relation (or the relation itself, with pageNo -1)
+// in mode for curTxn. A lock that another transaction holds in a mode in
+// conflict is not waited for here, as the statement asking for it holds
+// pages pinned: the request is queued and LOCKWAIT returned, so that the
+// statement is undone and run again once TX_Wait returns. If queueing
+// the request would close a cycle of transactions waiting for each other,
+// DEADLOCK is returned instead and the transaction is to be aborted. With
+// wait false, LOCKWAIT is returned without queueing the request.
+const Status TX_Lock(const string& relation, const int pageNo,
+                     const LockMode mode, const bool wait = true);
+
+// Wait until the lock txn was queued for is granted.
+const Status TX_Wait(Transaction* txn);
+
+// Log the insert of record rid into relation, the delete of the record
+// stored at rid, or the stamp put on record rid by a delete, for curTxn.
+void TX_LogInsert(const string& relation, const RID& rid);
+void TX_LogDelete(const string& relation, const RID& rid,
+                  const Record& stored);
+void TX_LogStamp(const string& relation, const RID& rid);
+
+// Drop the undo log entries of relation, whose records have moved (e.g.
+// by vacuum), and with TX_Drop also the locks on it, once it is destroyed.
+void TX_Forget(const string& relation);
+void TX_Drop(const string& relation);
+
+// Functions called before and after a transaction waits for a lock, for a
+// server to let other sessions run meanwhile.
+void TX_SetWaitHooks(void (*before)(), void (*after)());
+
+#endif
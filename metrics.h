@@ -0,0 +1,117 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdio.h>
+#include <time.h>
+
+#include <map>
+#include <string>
+
+using namespace std;
+
+// Number of buckets of a latency histogram. Bucket 0 counts latencies
+// under 1 microsecond, bucket i those from 2^(i-1) up to 2^i microseconds
+// and the last bucket everything longer.
+const int LATBUCKETS = 24;
+
+// Histogram of operation latencies with power of two buckets.
+
+class LatencyHist {
+   public:
+    LatencyHist() { clear(); }
+
+    void add(const long nsecs);  // record one operation
+    void clear();
+
+    long count() const { return cnt; }
+    double meanUsecs() const { return cnt ? sumNsecs / 1000.0 / cnt : 0; }
+    double maxUsecs() const { return maxNsecs / 1000.0; }
+
+    // upper bound (in microseconds) of the bucket holding the p-th
+    // fraction of the operations, 0 <= p <= 1
+    double percentile(const double p) const;
+
+    long buckets[LATBUCKETS];  // number of operations per bucket
+
+   private:
+    long cnt;       // number of operations
+    long sumNsecs;  // total latency
+    long maxNsecs;  // largest latency
+};
+
+// Reasons a page leaves the buffer pool.
+enum EvictReason {
+    EVICT_CLEAN,    // replaced by the clock algorithm, page was clean
+    EVICT_DIRTY,    // replaced by the clock algorithm after writing it
+    EVICT_FLUSH,    // dropped by flushFile, e.g. when its file closed
+    EVICT_DISPOSE,  // page disposed of
+    NUMEVICTREASONS
+};
+
+// Buffer pool metrics of one file.
+struct FileMetrics {
+    long hits;    // BufMgr::readPage calls that found the page in the pool
+    long misses;  // BufMgr::readPage calls that had to read the page
+    long allocs;  // pages allocated through BufMgr::allocPage
+    long reads;   // pages read from the file
+    long writes;  // pages written to the file
+    long evictions[NUMEVICTREASONS];  // pages leaving the pool, by reason
+    int pinned;     // frames of the file pinned right now
+    int pinnedMax;  // high-water mark of pinned
+};
+
+// Buffer pool, file I/O, lock and scan metrics. Counters are kept per file
+// name, so they accumulate over every time a file is opened; they are only
+// reset by clear().
+
+class Metrics {
+   public:
+    Metrics() : pinned(0) { clear(); }
+
+    // counters of file fileName, set up on first use; the returned
+    // pointer stays valid for the life of the program
+    FileMetrics* file(const string& fileName);
+
+    // a frame of file fm became pinned (delta 1) or unpinned (delta -1)
+    void pin(FileMetrics* fm, const int delta) {
+        fm->pinned += delta;
+        if (fm->pinned > fm->pinnedMax) fm->pinnedMax = fm->pinned;
+        pinned += delta;
+        if (pinned > pinnedMax) pinnedMax = pinned;
+    }
+
+    // zero every counter and histogram; the pinned frame counts are kept
+    // and become the new high-water marks
+    void clear();
+
+    void print(FILE* out) const;  // print as tables
+    void dump(FILE* out) const;   // print as a JSON object
+
+    LatencyHist fileRead;   // File::readPage
+    LatencyHist fileWrite;  // File::writePage
+    LatencyHist bufRead;    // BufMgr::readPage
+    int pinned;             // frames pinned right now
+    int pinnedMax;          // high-water mark of pinned
+
+    long lockRequests;     // lock requests that went to the lock table
+    long lockWaits;        // requests that waited for other transactions
+    long deadlocks;        // requests refused to break a deadlock
+    long escalations;      // page locks traded for a relation lock
+    LatencyHist lockWait;  // time the waits took
+
+    long sharedScans;  // scans started at the page other scans were on
+
+   private:
+    map<string, FileMetrics> files;  // counters by file name
+};
+
+extern Metrics metrics;
+
+// monotonic clock in nanoseconds, for latencies
+inline long nowNsecs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+#endif
@@ -27,11 +27,12 @@ const unsigned PAGEDATASIZE = PAGESIZE - DPFIXED + sizeof(slot_t);
 // size of the data area of a page
 
 // Class definition for a minirel data page.
-// The design assumes that records are kept compacted when
-// deletions are performed. Notice, however, that the slot
-// array cannot be compacted.  Notice, this class does not keep
-// the records align, relying instead on upper levels to take
-// care of non-aligned attributes
+// Deleted records leave holes that are squeezed out later by
+// compact(), which heap file scans call when they leave a page
+// they deleted from and inserts call when they need the space.
+// Notice, however, that the slot array cannot be compacted.
+// Notice, this class does not keep the records align, relying
+// instead on upper levels to take care of non-aligned attributes
 
 class Page {
    private:
@@ -40,7 +41,7 @@ class Page {
     short slotCnt;    // number of slots in use;
     short freePtr;    // offset of first free byte in data[]
     short freeSpace;  // number of bytes free in data[]
-    short dummy;      // for alignment purposes
+    short deadSpace;  // bytes of deleted records not yet reclaimed
     int nextPage;     // forwards pointer
     int curPage;      // page number of current pointer
 
@@ -56,9 +57,25 @@ class Page {
     // inserts a new record (rec) into the page, returns RID of record
     const Status insertRecord(const Record& rec, RID& rid);
 
-    // delete the record with the specified rid
+    // reserves space for a new record of length bytes on the page, returns
+    // RID of record and pointer to its data, which the caller fills in
+    const Status reserveRecord(const int length, RID& rid, char*& recPtr);
+
+    // shorten a record of the page to its first length bytes
+    const Status shrinkRecord(const RID& rid, const int length);
+
+    // delete the record with the specified rid; its space is reclaimed by
+    // the next compact()
     const Status deleteRecord(const RID& rid);
 
+    // put record rec back at rid, which it was deleted from; the slot
+    // array grows back to its slot if it has shrunk since
+    const Status restoreRecord(const RID& rid, const Record& rec);
+
+    // move the records together to reclaim the space of deleted records;
+    // RIDs do not change. Returns true if anything moved.
+    const bool compact();
+
     // returns RID of first record on page
     // returns  NORECORDS if page contains no records.  Otherwise, returns OK
     const Status firstRecord(RID& firstRid) const;
@@ -11,8 +11,17 @@ typedef struct {
   char *attrName;                       // relation name
   int attrType;                         // type of attribute
   int attrLen;                          // length of attribute
+  int attrFlags;                        // ATTRVARLEN or ATTRDICT
 } ATTR_DESCR;
 
+//
+// format of a varchar(n) and a dictionary encoded char(n) dict attribute
+// in an attribute type node; char(n) is just n
+//
+
+#define VARCHARFMT 256
+#define DICTFMT 512
+
 
 //
 // REL_ATTR: describes a qualified attribute (relName.attrName)
@@ -56,7 +65,15 @@ typedef enum {
     N_DROP,
     N_LOAD,
     N_PRINT,
+    N_REORGANIZE,
+    N_VACUUM,
+    N_ANALYZE,
+    N_CLUSTER,
+    N_EXPLAIN,
+    N_STATS,
+    N_TRACE,
     N_HELP,
+    N_TRANSACT,
     N_SELECT,
     N_JOIN,
     N_PRIMATTR,
@@ -65,7 +82,8 @@ typedef enum {
     N_ATTRTYPE,
     N_VALUE,
     N_LIST,
-    N_ALIAS
+    N_ALIAS,
+    N_ORDER
 } NODEKIND;
 
 
@@ -82,12 +100,15 @@ typedef struct node {
 	    char *relname;
 	    struct node *attrlist;
 	    struct node *qual;
+	    struct node *groupby;
+	    struct node *order;
 	} QUERY;
 
 	// insert node */
 	struct {
 	    char *relname;
 	    struct node *attrlist;
+	    struct node *rows;		// list of value lists
 	} INSERT;
 
 	// delete node */
@@ -125,6 +146,7 @@ typedef struct node {
 	struct {
 	    char *relname;
 	    char *filename;
+	    int csv;			// file is text, comma separated
 	} LOAD;
 
 	// pprint node */
@@ -132,11 +154,54 @@ typedef struct node {
 	    char *relname;
 	} PRINT;
 
+	// reorganize node */
+	struct {
+	    char *relname;
+	} REORGANIZE;
+
+	// vacuum node */
+	struct {
+	    char *relname;
+	} VACUUM;
+
+	// analyze node */
+	struct {
+	    char *relname;
+	} ANALYZE;
+
+	// cluster node */
+	struct {
+	    char *relname;
+	    char *attrname;             // NULL to cluster as before
+	} CLUSTER;
+
+	// explain node */
+	struct {
+	    int analyze;                // run the query too
+	    struct node *query;
+	} EXPLAIN;
+
+	// stats node */
+	struct {
+	    char *filename;             // file to dump to, or NULL
+	    int reset;                  // clear the metrics instead
+	} STATS;
+
+	// trace node */
+	struct {
+	    char *filename;             // file to trace to, or NULL to stop
+	} TRACE;
+
 	// help node */
 	struct {
 	    char *relname;
 	} HELP;
 
+	// begin, commit or abort node */
+	struct {
+	    int op;                     // RW_BEGIN, RW_COMMIT or RW_ABORT
+	} TRANSACT;
+
 	// select node */
 	struct {
 	    struct node *selattr;
@@ -154,7 +219,9 @@ typedef struct node {
 	// qualified attribute node */
 	struct {
 	    char *relname;
-	    char *attrname;
+	    char *attrname;             // NULL for count(*)
+	    int aggr;                   // aggregate function applied to the
+					// attribute (an AggFunc), or NoAgg
 	} QUALATTR;
 
 	// primary attribute node */
@@ -203,6 +270,13 @@ typedef struct node {
 	  char *relname;
 	  char *alias;
 	} ALIAS;
+
+	// order by and limit node */
+	struct {
+	  struct node *attr;            // NULL if there is no order by
+	  int desc;                     // 1 for descending order
+	  int limit;                    // -1 if there is no limit
+	} ORDER;
     } u;
 } NODE;
 
@@ -212,20 +286,30 @@ typedef struct node {
 //
 
 NODE *newnode(int kind);
-NODE *query_node(char *relname, NODE *attrlist, NODE *n);
-NODE *insert_node(char *relname, NODE *attrlist);
+NODE *query_node(char *relname, NODE *attrlist, NODE *n, NODE *groupby,
+		 NODE *order);
+NODE *insert_node(char *relname, NODE *attrlist, NODE *rows);
 NODE *delete_node(char *relname, NODE *qual);
 NODE *create_node(char *relname, NODE *attrlist, NODE *primattr);
 NODE *destroy_node(char *relname);
 NODE *build_node(char *relname, char *attrname, int nbuckets);
 NODE *rebuild_node(char *relname, char *attrname, int nbuckets);
 NODE *drop_node(char *relname, char *attrname);
-NODE *load_node(char *relname, char *filename);
+NODE *load_node(char *relname, char *filename, int csv);
 NODE *print_node(char *relname);
+NODE *reorganize_node(char *relname);
+NODE *vacuum_node(char *relname);
+NODE *analyze_node(char *relname);
+NODE *cluster_node(char *relname, char *attrname);
+NODE *explain_node(int analyze, NODE *query);
+NODE *stats_node(char *filename, int reset);
+NODE *trace_node(char *filename);
 NODE *help_node(char *relname);
+NODE *transact_node(int op);
 NODE *select_node(NODE *selattr, int op, NODE *value);
 NODE *join_node(NODE *joinattr1, int op, NODE *joinattr2);
 NODE *qualattr_node(char *relname, char *attrname);
+NODE *aggr_node(int aggr, NODE *qualattr);
 NODE *primattr_node(char *attrname, int nbuckets);
 NODE *attrval_node(char *attrname, NODE *value);
 //attrtype_node need to change due to change of NODE.ATTRTYPE
@@ -237,6 +321,9 @@ NODE *list_node(NODE *n);
 NODE *prepend(NODE *n, NODE *list);
 NODE *merge_attr_value_list(NODE *attr_list, NODE *value_list);
 NODE *alias_node(char *relname, char *alias);
+NODE *order_node(NODE *attr, int desc, int limit);
 NODE *replace_alias_in_qualattr_list(NODE *alias, NODE *qualattr_list);
 NODE *replace_alias_in_condition(NODE *alias, NODE *where);
+
+int parse_text(const char *text);
 #endif
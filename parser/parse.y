@@ -5,7 +5,9 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include "heapfile.h"
+#include "query.h"
 #include "parse.h"
 
 extern "C" int isatty(int);
@@ -13,11 +15,16 @@ extern int yylex();
 extern int yywrap();
 extern void reset_scanner();
 extern void quit();
+extern void scan_text(const char *text);
+extern void resume_scan_text();
+extern void end_scan_text();
 
 void yyerror(char *);
 
 extern char *yytext;                    // tokens in string format
 static NODE *parse_tree;                // root of parse tree
+thread_local int text_input = 0;        // statements come from parse_text
+static thread_local int text_done;      // end of the text or quit
 %}
 
 %union{
@@ -33,9 +40,22 @@ static NODE *parse_tree;                // root of parse tree
 		RW_DROP
 		RW_DESTROY
 		RW_PRINT
+		RW_REORGANIZE
+		RW_VACUUM
+		RW_EXPLAIN
+		RW_ANALYZE
+		RW_CLUSTER
+		RW_ON
+		RW_STATS
+		RW_RESET
+		RW_TRACE
 		RW_LOAD
+		RW_FORMAT
 		RW_HELP
 		RW_QUIT
+		RW_BEGIN
+		RW_COMMIT
+		RW_ABORT
 		RW_SELECT
 		RW_INTO
 		RW_WHERE
@@ -51,9 +71,22 @@ static NODE *parse_tree;                // root of parse tree
 		RW_OR
 		RW_NOT
 		RW_VALUES	
+		RW_GROUP
+		RW_BY
+		RW_COUNT
+		RW_SUM
+		RW_MIN
+		RW_MAX
+		RW_AVG
+		RW_ORDER
+		RW_ASC
+		RW_DESC
+		RW_LIMIT
 		INT_TYPE
 		REAL_TYPE
 		CHAR_TYPE	
+		VARCHAR_TYPE
+		RW_DICT
 		T_EQ
 		T_LT
 		T_LE
@@ -73,9 +106,13 @@ static NODE *parse_tree;                // root of parse tree
 		T_SHELL_CMD
 
 %type	<ival>	op
+		aggr
+		opt_desc
+		opt_limit
 
 %type	<sval>	opt_into_relname
 		opt_relname
+		opt_on_attr
 		string
 
 %type	<n>	command
@@ -91,13 +128,25 @@ static NODE *parse_tree;                // root of parse tree
 		drop
 		load
 		print
+		reorganize
+		vacuum
+		analyze
+		cluster
+		explain
+		stats
+		trace
 		help
+		transact
 		quit
 		opt_primary_attr
 		opt_where
+		opt_groupby
+		opt_order
 		qual
 		selection
 		join
+		non_mt_selattr_list
+		selattr
 		non_mt_qualattr_list
 		qualattr
 /*
@@ -110,6 +159,7 @@ static NODE *parse_tree;                // root of parse tree
 		attrib
 		attrib_list
 		value_list
+		row_list
 		val
 		table_list
 		table
@@ -123,9 +173,13 @@ start
 	}
 	| T_SHELL_CMD
 	{
-	        if(!isatty(0))
-		    puts($1);
-		(void)system($1);
+	        if(text_input)
+		    puts("shell commands are not run for clients");
+	        else {
+		    if(!isatty(0))
+		        puts($1);
+		    (void)system($1);
+		}
 		parse_tree = NULL;
 		YYACCEPT;
 	}
@@ -137,7 +191,11 @@ start
 	}
 	| T_EOF
 	{
-		quit();
+		if(!text_input)
+		    quit();
+		text_done = 1;
+		parse_tree = NULL;
+		YYACCEPT;
 	}
 	;
 
@@ -154,7 +212,15 @@ command
 	| drop
 	| load
 	| print
+	| reorganize
+	| vacuum
+	| analyze
+	| cluster
+	| explain
+	| stats
+	| trace
 	| help
+	| transact
 	| quit
 	| nothing
 	{
@@ -163,21 +229,31 @@ command
 	;
 
 query
-	: RW_SELECT non_mt_qualattr_list opt_into_relname RW_FROM table_list opt_where
+	: RW_SELECT non_mt_selattr_list opt_into_relname RW_FROM table_list opt_where
+	  opt_groupby opt_order
 /*	RW_SELECT opt_into_relname '(' non_mt_qualattr_list ')' opt_where */
 	{
-		NODE *where;
+		NODE *where, *groupby, *order;
 		NODE *qualattr_list = replace_alias_in_qualattr_list($5, $2);
 		if (qualattr_list == NULL) { // something wrong in qualattr_list
 		  $$ = NULL;
 		}
 		else {
 		  where = replace_alias_in_condition($5, $6);
+		  groupby = $7 ? replace_alias_in_qualattr_list($5, $7) : NULL;
 		  if ((where == NULL) && ($6 != NULL)) {
 		     $$ = NULL; //something wrong in where condition
 		  }
+		  else if ((groupby == NULL) && ($7 != NULL)) {
+		     $$ = NULL; //something wrong in group by list
+		  }
+		  else if ($8 && $8->u.ORDER.attr &&
+			   !replace_alias_in_qualattr_list($5,
+					list_node($8->u.ORDER.attr))) {
+		     $$ = NULL; //something wrong in order by attribute
+		  }
 		  else {
-		    $$ = query_node($3, qualattr_list, where);
+		    $$ = query_node($3, qualattr_list, where, groupby, $8);
 		  }
 		}
 	}
@@ -208,11 +284,16 @@ table
 	}
 
 insert
-	: RW_INSERT RW_INTO string '(' attrib_list ')' RW_VALUES '(' value_list ')' 
-	{
-		NODE* tmp = merge_attr_value_list($5, $9);
-		if (tmp == NULL) $$=NULL;
-		else $$ = insert_node($3, tmp);
+	: RW_INSERT RW_INTO string '(' attrib_list ')' RW_VALUES row_list
+	{
+		/* check every row against the attribute list */
+		NODE* row;
+		$$ = insert_node($3, $5, $8);
+		for (row = $8; row != NULL; row = row->u.LIST.next)
+		  if (merge_attr_value_list($5, row->u.LIST.self) == NULL) {
+		    $$ = NULL;
+		    break;
+		  }
 	}
 	;
 
@@ -242,6 +323,16 @@ value_list
 		$$ = list_node($1);
 	}
 
+row_list
+	: '(' value_list ')' ',' row_list
+	{
+		$$ = prepend($2, $5);
+	}
+	| '(' value_list ')'
+	{
+		$$ = list_node($2);
+	}
+
 val
 	: value 
 	{
@@ -299,7 +390,15 @@ drop
 load
 	: RW_LOAD RW_TABLE string RW_FROM '(' T_QSTRING ')'
 	{
-		$$ = load_node($3, $6);
+		$$ = load_node($3, $6, 0);
+	}
+	| RW_LOAD RW_TABLE string RW_FROM '(' T_QSTRING ')' RW_FORMAT string
+	{
+		if (strcmp($9, "csv")) {
+		  fprintf(stderr, "Error: unknown load format %s\n", $9);
+		  $$ = NULL;
+		}
+		else $$ = load_node($3, $6, 1);
 	}
 	;
 print
@@ -309,6 +408,71 @@ print
 	}
 	;
 
+reorganize
+	: RW_REORGANIZE string
+	{
+		$$ = reorganize_node($2);
+	}
+	;
+
+vacuum
+	: RW_VACUUM string
+	{
+		$$ = vacuum_node($2);
+	}
+	;
+
+analyze
+	: RW_ANALYZE string
+	{
+		$$ = analyze_node($2);
+	}
+	;
+
+cluster
+	: RW_CLUSTER string opt_on_attr
+	{
+		$$ = cluster_node($2, $3);
+	}
+	;
+
+explain
+	: RW_EXPLAIN query
+	{
+		$$ = $2 ? explain_node(0, $2) : NULL;
+	}
+	| RW_EXPLAIN RW_ANALYZE query
+	{
+		$$ = $3 ? explain_node(1, $3) : NULL;
+	}
+	;
+
+stats
+	: RW_STATS
+	{
+		$$ = stats_node(NULL, 0);
+	}
+	| RW_STATS RW_RESET
+	{
+		$$ = stats_node(NULL, 1);
+	}
+	| RW_STATS T_QSTRING
+	{
+		$$ = stats_node($2, 0);
+	}
+	;
+
+trace
+	: RW_TRACE T_QSTRING
+	{
+		$$ = trace_node($2);
+	}
+	| RW_TRACE
+	{
+		$$ = trace_node(NULL);
+	}
+	;
+
 help
 	: RW_HELP opt_relname
 	{
@@ -316,10 +480,28 @@ help
 	}
 	;
 
+transact
+	: RW_BEGIN
+	{
+		$$ = transact_node(RW_BEGIN);
+	}
+	| RW_COMMIT
+	{
+		$$ = transact_node(RW_COMMIT);
+	}
+	| RW_ABORT
+	{
+		$$ = transact_node(RW_ABORT);
+	}
+	;
+
 quit
-	: RW_QUIT ';'
+	: RW_QUIT
 	{
-		quit();
+		if(!text_input)
+		    quit();
+		text_done = 2;
+		$$ = NULL;
 	}
 	;
 
@@ -355,6 +537,17 @@ opt_relname
 		$$ = NULL;
 	}
 	;
+
+opt_on_attr
+	: RW_ON string
+	{
+		$$ = $2;
+	}
+	| nothing
+	{
+		$$ = NULL;
+	}
+	;
 	
 opt_where
 	: RW_WHERE qual
@@ -367,6 +560,66 @@ opt_where
 	}
 	;
 
+opt_groupby
+	: RW_GROUP RW_BY non_mt_qualattr_list
+	{
+		$$ = $3;
+	}
+	| nothing
+	{
+		$$ = NULL;
+	}
+	;
+
+opt_order
+	: RW_ORDER RW_BY selattr opt_desc opt_limit
+	{
+		$$ = order_node($3, $4, $5);
+	}
+	| RW_LIMIT T_INT
+	{
+		if ($2 < 0) {
+		  yyerror("limit must not be negative");
+		  YYERROR;
+		}
+		$$ = order_node(NULL, 0, $2);
+	}
+	| nothing
+	{
+		$$ = NULL;
+	}
+	;
+
+opt_desc
+	: RW_DESC
+	{
+		$$ = 1;
+	}
+	| RW_ASC
+	{
+		$$ = 0;
+	}
+	| nothing
+	{
+		$$ = 0;
+	}
+	;
+
+opt_limit
+	: RW_LIMIT T_INT
+	{
+		if ($2 < 0) {
+		  yyerror("limit must not be negative");
+		  YYERROR;
+		}
+		$$ = $2;
+	}
+	| nothing
+	{
+		$$ = -1;
+	}
+	;
+
 qual
 	: selection
 	| join
@@ -386,6 +639,56 @@ join
 	}
 	;
 
+non_mt_selattr_list
+	: '(' non_mt_selattr_list ')'
+	{
+		$$ = $2;
+	}
+	| selattr ',' non_mt_selattr_list
+	{
+		$$ = prepend($1, $3);
+	}
+	| selattr
+	{
+		$$ = list_node($1);
+	}
+	;
+
+selattr
+	: qualattr
+	| aggr '(' qualattr ')'
+	{
+		$$ = aggr_node($1, $3);
+	}
+	| RW_COUNT '(' qualattr ')'
+	{
+		$$ = aggr_node(CountAgg, $3);
+	}
+	| RW_COUNT '(' '*' ')'
+	{
+		$$ = aggr_node(CountAgg, qualattr_node(NULL, NULL));
+	}
+	;
+
+aggr
+	: RW_SUM
+	{
+		$$ = SumAgg;
+	}
+	| RW_MIN
+	{
+		$$ = MinAgg;
+	}
+	| RW_MAX
+	{
+		$$ = MaxAgg;
+	}
+	| RW_AVG
+	{
+		$$ = AvgAgg;
+	}
+	;
+
 non_mt_qualattr_list
 	: '(' non_mt_qualattr_list ')'
 	{
@@ -454,10 +757,18 @@ attrtype
 	{
 	 	$$ = attrtype_node($1, $4->u.VALUE.u.ival);
 	}
+	| string CHAR_TYPE '(' value ')' RW_DICT
+	{
+	 	$$ = attrtype_node($1, DICTFMT + $4->u.VALUE.u.ival);
+	}
 	| string CHAR_TYPE
 	{
 		$$ = attrtype_node($1, 2);
 	}
+	| string VARCHAR_TYPE '(' value ')'
+	{
+		$$ = attrtype_node($1, VARCHARFMT + $4->u.VALUE.u.ival);
+	}
 	;
 
 op
@@ -518,7 +829,7 @@ nothing
 void parse(void)
 {
   extern void new_query();
-  extern void interp(NODE *);
+  extern void run_query(NODE *);
 
   for(;;){
 
@@ -531,11 +842,43 @@ void parse(void)
 
     // if a query was successfully read, interpret it
     if(yyparse() == 0 && parse_tree != NULL)
-      interp(parse_tree);
+      run_query(parse_tree);
   }
 }
 
 
+//
+// parse_text: interprets the statements of text, as parse() does those
+// typed in, for a client of the server. Shell commands are not run, and
+// quit ends the session instead of the program. The scanner, nodes and
+// text of a session are kept by its thread, so a statement may wait for a
+// lock while those of other sessions are parsed.
+//
+// Returns 1 if the session ended with quit, 0 otherwise.
+//
+
+int parse_text(const char *text)
+{
+  extern void new_query();
+  extern void run_query(NODE *);
+
+  text_input = 1;
+  text_done = 0;
+  scan_text(text);
+
+  while(!text_done){
+    new_query();
+    resume_scan_text();
+    if(yyparse() == 0 && parse_tree != NULL)
+      run_query(parse_tree);
+  }
+
+  end_scan_text();
+  text_input = 0;
+  return text_done == 2;
+}
+
+
 void yyerror(char *s)
 {
   puts(s);
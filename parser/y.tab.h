@@ -60,40 +60,66 @@ extern int yydebug;
     RW_DROP = 261,                 /* RW_DROP  */
     RW_DESTROY = 262,              /* RW_DESTROY  */
     RW_PRINT = 263,                /* RW_PRINT  */
-    RW_LOAD = 264,                 /* RW_LOAD  */
-    RW_HELP = 265,                 /* RW_HELP  */
-    RW_QUIT = 266,                 /* RW_QUIT  */
-    RW_SELECT = 267,               /* RW_SELECT  */
-    RW_INTO = 268,                 /* RW_INTO  */
-    RW_WHERE = 269,                /* RW_WHERE  */
-    RW_INSERT = 270,               /* RW_INSERT  */
-    RW_DELETE = 271,               /* RW_DELETE  */
-    RW_PRIMARY = 272,              /* RW_PRIMARY  */
-    RW_NUMBUCKETS = 273,           /* RW_NUMBUCKETS  */
-    RW_ALL = 274,                  /* RW_ALL  */
-    RW_FROM = 275,                 /* RW_FROM  */
-    RW_AS = 276,                   /* RW_AS  */
-    RW_TABLE = 277,                /* RW_TABLE  */
-    RW_AND = 278,                  /* RW_AND  */
-    RW_OR = 279,                   /* RW_OR  */
-    RW_NOT = 280,                  /* RW_NOT  */
-    RW_VALUES = 281,               /* RW_VALUES  */
-    INT_TYPE = 282,                /* INT_TYPE  */
-    REAL_TYPE = 283,               /* REAL_TYPE  */
-    CHAR_TYPE = 284,               /* CHAR_TYPE  */
-    T_EQ = 285,                    /* T_EQ  */
-    T_LT = 286,                    /* T_LT  */
-    T_LE = 287,                    /* T_LE  */
-    T_GT = 288,                    /* T_GT  */
-    T_GE = 289,                    /* T_GE  */
-    T_NE = 290,                    /* T_NE  */
-    T_EOF = 291,                   /* T_EOF  */
-    NOTOKEN = 292,                 /* NOTOKEN  */
-    T_INT = 293,                   /* T_INT  */
-    T_REAL = 294,                  /* T_REAL  */
-    T_STRING = 295,                /* T_STRING  */
-    T_QSTRING = 296,               /* T_QSTRING  */
-    T_SHELL_CMD = 297              /* T_SHELL_CMD  */
+    RW_REORGANIZE = 264,           /* RW_REORGANIZE  */
+    RW_VACUUM = 265,               /* RW_VACUUM  */
+    RW_EXPLAIN = 266,              /* RW_EXPLAIN  */
+    RW_ANALYZE = 267,              /* RW_ANALYZE  */
+    RW_CLUSTER = 268,              /* RW_CLUSTER  */
+    RW_ON = 269,                   /* RW_ON  */
+    RW_STATS = 270,                /* RW_STATS  */
+    RW_RESET = 271,                /* RW_RESET  */
+    RW_TRACE = 272,                /* RW_TRACE  */
+    RW_LOAD = 273,                 /* RW_LOAD  */
+    RW_FORMAT = 274,               /* RW_FORMAT  */
+    RW_HELP = 275,                 /* RW_HELP  */
+    RW_QUIT = 276,                 /* RW_QUIT  */
+    RW_BEGIN = 277,                /* RW_BEGIN  */
+    RW_COMMIT = 278,               /* RW_COMMIT  */
+    RW_ABORT = 279,                /* RW_ABORT  */
+    RW_SELECT = 280,               /* RW_SELECT  */
+    RW_INTO = 281,                 /* RW_INTO  */
+    RW_WHERE = 282,                /* RW_WHERE  */
+    RW_INSERT = 283,               /* RW_INSERT  */
+    RW_DELETE = 284,               /* RW_DELETE  */
+    RW_PRIMARY = 285,              /* RW_PRIMARY  */
+    RW_NUMBUCKETS = 286,           /* RW_NUMBUCKETS  */
+    RW_ALL = 287,                  /* RW_ALL  */
+    RW_FROM = 288,                 /* RW_FROM  */
+    RW_AS = 289,                   /* RW_AS  */
+    RW_TABLE = 290,                /* RW_TABLE  */
+    RW_AND = 291,                  /* RW_AND  */
+    RW_OR = 292,                   /* RW_OR  */
+    RW_NOT = 293,                  /* RW_NOT  */
+    RW_VALUES = 294,               /* RW_VALUES  */
+    RW_GROUP = 295,                /* RW_GROUP  */
+    RW_BY = 296,                   /* RW_BY  */
+    RW_COUNT = 297,                /* RW_COUNT  */
+    RW_SUM = 298,                  /* RW_SUM  */
+    RW_MIN = 299,                  /* RW_MIN  */
+    RW_MAX = 300,                  /* RW_MAX  */
+    RW_AVG = 301,                  /* RW_AVG  */
+    RW_ORDER = 302,                /* RW_ORDER  */
+    RW_ASC = 303,                  /* RW_ASC  */
+    RW_DESC = 304,                 /* RW_DESC  */
+    RW_LIMIT = 305,                /* RW_LIMIT  */
+    INT_TYPE = 306,                /* INT_TYPE  */
+    REAL_TYPE = 307,               /* REAL_TYPE  */
+    CHAR_TYPE = 308,               /* CHAR_TYPE  */
+    VARCHAR_TYPE = 309,            /* VARCHAR_TYPE  */
+    RW_DICT = 310,                 /* RW_DICT  */
+    T_EQ = 311,                    /* T_EQ  */
+    T_LT = 312,                    /* T_LT  */
+    T_LE = 313,                    /* T_LE  */
+    T_GT = 314,                    /* T_GT  */
+    T_GE = 315,                    /* T_GE  */
+    T_NE = 316,                    /* T_NE  */
+    T_EOF = 317,                   /* T_EOF  */
+    NOTOKEN = 318,                 /* NOTOKEN  */
+    T_INT = 319,                   /* T_INT  */
+    T_REAL = 320,                  /* T_REAL  */
+    T_STRING = 321,                /* T_STRING  */
+    T_QSTRING = 322,               /* T_QSTRING  */
+    T_SHELL_CMD = 323              /* T_SHELL_CMD  */
   };
   typedef enum yytokentype yytoken_kind_t;
 #endif
@@ -108,53 +134,79 @@ extern int yydebug;
 #define RW_DROP 261
 #define RW_DESTROY 262
 #define RW_PRINT 263
-#define RW_LOAD 264
-#define RW_HELP 265
-#define RW_QUIT 266
-#define RW_SELECT 267
-#define RW_INTO 268
-#define RW_WHERE 269
-#define RW_INSERT 270
-#define RW_DELETE 271
-#define RW_PRIMARY 272
-#define RW_NUMBUCKETS 273
-#define RW_ALL 274
-#define RW_FROM 275
-#define RW_AS 276
-#define RW_TABLE 277
-#define RW_AND 278
-#define RW_OR 279
-#define RW_NOT 280
-#define RW_VALUES 281
-#define INT_TYPE 282
-#define REAL_TYPE 283
-#define CHAR_TYPE 284
-#define T_EQ 285
-#define T_LT 286
-#define T_LE 287
-#define T_GT 288
-#define T_GE 289
-#define T_NE 290
-#define T_EOF 291
-#define NOTOKEN 292
-#define T_INT 293
-#define T_REAL 294
-#define T_STRING 295
-#define T_QSTRING 296
-#define T_SHELL_CMD 297
+#define RW_REORGANIZE 264
+#define RW_VACUUM 265
+#define RW_EXPLAIN 266
+#define RW_ANALYZE 267
+#define RW_CLUSTER 268
+#define RW_ON 269
+#define RW_STATS 270
+#define RW_RESET 271
+#define RW_TRACE 272
+#define RW_LOAD 273
+#define RW_FORMAT 274
+#define RW_HELP 275
+#define RW_QUIT 276
+#define RW_BEGIN 277
+#define RW_COMMIT 278
+#define RW_ABORT 279
+#define RW_SELECT 280
+#define RW_INTO 281
+#define RW_WHERE 282
+#define RW_INSERT 283
+#define RW_DELETE 284
+#define RW_PRIMARY 285
+#define RW_NUMBUCKETS 286
+#define RW_ALL 287
+#define RW_FROM 288
+#define RW_AS 289
+#define RW_TABLE 290
+#define RW_AND 291
+#define RW_OR 292
+#define RW_NOT 293
+#define RW_VALUES 294
+#define RW_GROUP 295
+#define RW_BY 296
+#define RW_COUNT 297
+#define RW_SUM 298
+#define RW_MIN 299
+#define RW_MAX 300
+#define RW_AVG 301
+#define RW_ORDER 302
+#define RW_ASC 303
+#define RW_DESC 304
+#define RW_LIMIT 305
+#define INT_TYPE 306
+#define REAL_TYPE 307
+#define CHAR_TYPE 308
+#define VARCHAR_TYPE 309
+#define RW_DICT 310
+#define T_EQ 311
+#define T_LT 312
+#define T_LE 313
+#define T_GT 314
+#define T_GE 315
+#define T_NE 316
+#define T_EOF 317
+#define NOTOKEN 318
+#define T_INT 319
+#define T_REAL 320
+#define T_STRING 321
+#define T_QSTRING 322
+#define T_SHELL_CMD 323
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 union YYSTYPE
 {
-#line 23 "parse.y"
+#line 30 "parse.y"
 
   int ival;
   float rval;
   char *sval;
   NODE *n;
 
-#line 158 "y.tab.h"
+#line 210 "y.tab.h"
 
 };
 typedef union YYSTYPE YYSTYPE;
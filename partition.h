@@ -2,24 +2,47 @@
 #define PARTITION_H
 
 #include "heapfile.h"
+#include "spill.h"
 
 // define if debug output wanted
 // #define DEBUGPART
 
+// hash function used to assign a record to one of P partitions; must
+// return a value in the range 0 to P-1. arg is passed through from the
+// user of the hook and says what to hash on, e.g. the key attribute.
+typedef const int (*PartHashFcn)(const Record& rec, const int P, void* arg);
+
 class Partition {
    public:
+    Partition(const string& fileName,  // (base) name of spill files
+              const int P,             // number of partitions
+              PartHashFcn hashfcn,     // hash function to use
+              void* hashArg,           // its argument
+              Status& status);         // create empty partitions
     Partition(HeapFileScan* rel,       // name of heap file to partition
-              const string& fileName,  // (base) name of heap file
+              const string& fileName,  // (base) name of spill files
               const int P,             // number of partitions
-              const int (*hashfcn)(const Record& rec, const int P),
-              // hash function to use in partitioning
-              string*& partName,  // names of partitioned heap files
-              Status& status);    // create partitions of file
-    ~Partition();                 // destroy partitions
+              PartHashFcn hashfcn,     // hash function to use
+              void* hashArg,           // its argument
+              Status& status);         // create partitions of file
+    ~Partition();                      // destroy partitions
+
+    // add rec to the partition the hash function picks
+    const Status insert(const Record& rec);
+
+    // write out all partitions; no further inserts
+    const Status finish();
+
+    // partition p, to be read with startScan() and scanNext()
+    SpillFile* getPart(const int p) const { return part[p]; }
 
    private:
+    const Status create(const string& fileName);  // create the spill files
+
     int P;             // number of partitions
-    string* partName;  // partition names
+    PartHashFcn hash;  // hash function
+    void* hashArg;     // and its argument
+    SpillFile** part;  // the partitions
 };
 
 #endif
@@ -0,0 +1,51 @@
+#ifndef PROJECT_H
+#define PROJECT_H
+
+#include <cstring>
+#include <vector>
+
+#include "catalog.h"
+
+// Projection plan: the list of copies that assembles an output tuple from
+// the attributes of one or two source tuples. The plan is computed once
+// per operator; attributes that are adjacent in both the source and the
+// output tuple are coalesced into a single copy.
+
+class ProjPlan {
+   public:
+    // projected attributes from a single relation
+    ProjPlan(const int projCnt, const AttrDesc projDescs[]);
+
+    // projected attributes from two relations, where an attribute of
+    // relation rel1 comes from source 0 and any other from source 1
+    ProjPlan(const int projCnt, const AttrDesc projDescs[], const char* rel1);
+
+    // length of an output tuple
+    int getRecLen() const { return reclen; }
+
+    // number of copies, after coalescing
+    int getCopyCnt() const { return copies.size(); }
+
+    // assemble the output tuple at out from tuples src0 and src1
+    void project(const char* src0, const char* src1, char* out) const {
+        for (unsigned int i = 0; i < copies.size(); i++) {
+            const ProjCopy& c = copies[i];
+            memcpy(out, (c.src ? src1 : src0) + c.srcOffset, c.len);
+            out += c.len;
+        }
+    }
+
+   private:
+    struct ProjCopy {
+        int src;        // source tuple (0 or 1)
+        int srcOffset;  // offset of the bytes in the source tuple
+        int len;        // number of bytes copied
+    };
+
+    std::vector<ProjCopy> copies;  // copies in output order
+    int reclen;                    // length of an output tuple
+
+    void addCopy(const int src, const AttrDesc& attr);
+};
+
+#endif
@@ -1,22 +1,36 @@
 #ifndef QUERY_H
 #define QUERY_H
 
-#include "heapfile.h"
+#include "catalog.h"
 
 enum JoinType { NLJoin, SMJoin, HashJoin };
 
+// aggregate function computed for an output attribute of QU_Aggregate;
+// NoAgg marks a grouping attribute
+enum AggFunc { NoAgg, CountAgg, SumAgg, MinAgg, MaxAgg, AvgAgg };
+
 //
 // Prototypes for query layer functions
 //
 
 const Status QU_Select(const string& result, const int projCnt,
                        const attrInfo projNames[], const attrInfo* attr,
-                       const Operator op, const char* attrValue);
+                       const Operator op, const char* attrValue,
+                       const attrInfo* orderAttr = NULL,
+                       const bool descending = false, const int limit = -1);
 
 const Status QU_Join(const string& result, const int projCnt,
                      const attrInfo projNames[], const attrInfo* attr1,
                      const Operator op, const attrInfo* attr2);
 
+const Status QU_Aggregate(const string& result, const int projCnt,
+                          const attrInfo projNames[], const AggFunc aggFuncs[],
+                          const int groupCnt, const attrInfo groupNames[],
+                          const attrInfo* attr, const Operator op,
+                          const char* attrValue);
+
+const Status QU_AggregateType(const AggFunc func, int& attrType, int& attrLen);
+
 const Status QU_Insert(const string& relation, const int attrCnt,
                        const attrInfo attrList[]);
 
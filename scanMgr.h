@@ -0,0 +1,32 @@
+// scanMgr.h — Shared Scan Manager
+// Declares the table of the scans in progress on each file, through which
+// a new scan starts at the page the others are reading.
+//
+// Statements run one at a time (see Server), and their scans end with
+// them, so the scans of different statements or sessions are never in
+// progress together: only those of one statement share, e.g. the inner
+// and outer scans of a relation joined with itself.
+
+#ifndef SCANMGR_H
+#define SCANMGR_H
+
+#include <string>
+
+using namespace std;
+
+// define if debug output wanted
+// #define DEBUGSCANMGR
+
+// Join the scans of file in progress. Returns the page the scan of file
+// that read a page last is on, for the new scan to read the pages from
+// there to the end of the file alongside it, and then wrap around to the
+// first page for those it missed; -1 if no scan has read a page yet.
+const int SS_Join(const string& file);
+
+// Report page pageNo of file as read by a scan that has joined.
+void SS_Report(const string& file, const int pageNo);
+
+// Leave the scans of file, once a scan that has joined them ends.
+void SS_Leave(const string& file);
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef SEMIJOIN_H
+#define SEMIJOIN_H
+
+#include "bloom.h"
+#include "catalog.h"
+
+// define if debug output wanted
+// #define DEBUGSJ
+
+// A semi-join filter is only built when the larger join input has at least
+// SJ_MINRATIO times as many tuples as the smaller one, and the smaller one
+// has no more than SJ_MAXKEYS tuples.
+const int SJ_MINRATIO = 4;
+const int SJ_MAXKEYS = 1 << 24;
+
+// Scan filter that passes only the records whose join attribute may match
+// a join attribute value of the other join input, as recorded in a bloom
+// filter over that input. False positives are possible, so a record that
+// passes still needs to be joined; records that fail cannot match.
+
+class JoinBloomFilter : public ScanFilter {
+   public:
+    JoinBloomFilter(const int expected,     // tuples in other input
+                    const AttrDesc& attr);  // join attr of filtered input
+
+    // add the join attribute value at keyPtr of the other input
+    void add(const char* keyPtr, const AttrDesc& keyAttr);
+
+    bool match(const Record& rec);
+
+   private:
+    BloomFilter bloom;  // hash values of the other input's join attribute
+    AttrDesc attr;      // join attribute of the filtered input
+};
+
+// Decide whether a semi-join filter pays off for the join of the relations
+// of attr1 and attr2. filteredRel returns 1 or 2 for the (larger) relation
+// that should be filtered, or 0 if no filter should be used.
+const Status SJ_ChooseFilter(const AttrDesc& attr1, const AttrDesc& attr2,
+                             int& filteredRel);
+
+// Scan the relation of buildAttr and build a filter for the relation of
+// probeAttr from its join attribute values.
+const Status SJ_BuildFilter(const AttrDesc& buildAttr,
+                            const AttrDesc& probeAttr,
+                            JoinBloomFilter*& filter);
+
+#endif
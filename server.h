@@ -0,0 +1,137 @@
+// server.h — Multi-client Server
+// Declares the server that runs the statements of local clients, sent over
+// a Unix domain socket, against one buffer pool and set of catalogs.
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <arpa/inet.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "error.h"
+#include "lockMgr.h"
+
+// define if debug output wanted
+// #define DEBUGSERVER
+
+// Number of threads that serve client sessions.
+const int SERVERTHREADS = 8;
+
+// Largest message of the protocol, in bytes.
+const unsigned int MAXFRAME = 64 * 1024 * 1024;
+
+// The protocol: a client sends one or more statements as text, and the
+// server replies with what they print. Every message is preceded by its
+// length as 4 bytes in network byte order. The server closes the session
+// after its reply to quit; a client may also just close the socket.
+
+// write len bytes at buf to socket fd; false if the socket is closed
+inline bool writeAll(const int fd, const char* buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = send(fd, buf, len, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        buf += n;
+        len -= n;
+    }
+    return true;
+}
+
+// read len bytes from socket fd to buf; false if the socket is closed
+inline bool readAll(const int fd, char* buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = recv(fd, buf, len, 0);
+        if (n <= 0) return false;
+        buf += n;
+        len -= n;
+    }
+    return true;
+}
+
+// write msg to socket fd as one message
+inline bool writeFrame(const int fd, const std::string& msg) {
+    uint32_t len = htonl(msg.size());
+    return writeAll(fd, (const char*)&len, sizeof(len)) &&
+           writeAll(fd, msg.data(), msg.size());
+}
+
+// read a message from socket fd into msg
+inline bool readFrame(const int fd, std::string& msg) {
+    uint32_t len;
+    if (!readAll(fd, (char*)&len, sizeof(len))) return false;
+    if ((len = ntohl(len)) > MAXFRAME) return false;
+    msg.resize(len);
+    return readAll(fd, &msg[0], len);
+}
+
+// Accepts clients on a Unix domain socket. Sessions waiting for their
+// next message are polled by run(); when one arrives, a thread of the pool
+// reads it, runs its statements and replies. The buffer manager, the
+// catalogs and the parser serve one statement at a time, so statements
+// run one after another, their output captured for the client that sent
+// them; the pool overlaps the sessions' socket I/O with them. A statement
+// waiting for a lock lets the others run meanwhile; should every thread
+// of the pool be waiting, another one is started, as the session holding
+// the lock may need one to commit.
+//
+// Statements of different sessions never run at the same time, not even
+// those that only read: a long select holds up a load of another session
+// until it is done. What multi-version records (see RecStamp) buy is that
+// a select does not wait for the locks a transaction of another session
+// holds between its statements.
+
+class Server {
+   public:
+    Server(const std::string& path,  // socket to listen on
+           const int threads, Status& status);
+    ~Server();
+
+    // serve clients until stop() is called or SIGINT or SIGTERM arrives
+    void run();
+
+    // make run() return; may be called from a signal handler
+    static void stop();
+
+   private:
+    void worker();
+    std::string execute(const std::string& text, Transaction*& txn,
+                        bool& quit);
+
+    // called by a worker before and after it waits for a lock
+    static void yieldExec();
+    static void resumeExec();
+
+    std::string path;  // of the socket
+    int listenFd;      // listening socket
+    int savedOut;      // the standard output and error of the server
+    int savedErr;
+
+    std::mutex lock;                   // protects all of the following
+    std::list<std::thread> workers;    // the pool
+    int blocked;                       // workers waiting for a lock
+    std::condition_variable ready;     // signalled when a session has input
+    std::deque<int> pending;           // sessions with input, for a worker
+    std::vector<int> served;           // sessions to poll again
+    std::set<int> sessions;            // all open sessions
+    std::map<int, Transaction*> txns;  // begun by sessions between messages
+    bool shutdown;
+
+    std::mutex execLock;  // held while statements run
+
+    static int wakeFds[2];                   // pipe that wakes up run()
+    static volatile sig_atomic_t stopping;  // stop() was called
+};
+
+#endif
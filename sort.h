@@ -2,10 +2,20 @@
 #define SORT_H
 
 #include "heapfile.h"
+#include "spill.h"
 
 // define if debug output wanted
 // #define DEBUGSORT
 
+// Memory (in bytes) a sort is given for its in-memory runs, and a top-N
+// selection for the tuples it keeps.
+const int SORTMEMBYTES = 512 * 1024;
+
+// Maximum number of sorted runs. All runs are merged at once, each with a
+// read buffer of SPILLBLOCK bytes, so on large files the runs are made
+// longer than the caller's maxItems.
+const int SORTMAXRUNS = 16;
+
 // SORTREC is an in-memory sort record that qsort(3) sorts.
 // The sort attribute as well as the associated RID are
 // stored in the record. The RID is used for fetching the
@@ -22,7 +32,9 @@ class SortedFile {
     SortedFile(const string& fileName,
                int offset,                 // sort source file on the given
                int length, Datatype type,  // attribute
-               int maxItems, Status& status);
+               int maxItems, Status& status,
+               ScanFilter* filter = NULL,     // only sort records it passes
+               const bool descending = false);  // largest values first
 
     Status next(Record& rec);  // fetch next record in sort order
     Status setMark();          // record a position in sort sequence
@@ -35,13 +47,11 @@ class SortedFile {
     Status startScans();               // start a scan on each sorted run
 
     typedef struct {
-        string name;              // name of run file
-        HeapFileScan* inFile;     // ptr to input file
-        InsertFileScan* outFile;  // ptr to output file
-        int valid;                // TRUE if recPtr has a record
-        Record rec;
-        RID rid;  // RID of current record of run
-        RID mark;
+        SpillFile* file;  // the sorted records of the run
+        int valid;        // TRUE if rec has been fetched
+        bool atEnd;       // TRUE if the run has no more records
+        Record rec;       // current record of run
+        bool markAtEnd;   // atEnd when the mark was set
     } RUN;
 
     vector<RUN> runs;  // holds info about each sub-run
@@ -52,10 +62,13 @@ class SortedFile {
     Datatype type;      // type of sort attribute
     int offset;         // offset of sort attribute
     int length;         // length of sort attribute
+    ScanFilter* filter;  // filter on source records, NULL if none
+    bool descending;     // sort in descending order
 
     SORTREC* buffer;  // in-memory sort buffer
     int maxItems;     // max. # of items/tuples in buffer
     int numItems;     // current # of items in buffer
+    int sortNo;       // tells the runs apart from those of other sorts
 };
 
 #endif
@@ -0,0 +1,88 @@
+#ifndef SPILL_H
+#define SPILL_H
+
+#include <string>
+
+#include "error.h"
+#include "page.h"
+
+using namespace std;
+
+// define if debug output wanted
+// #define DEBUGSPILL
+
+// Bytes a spill file collects before writing them out as one block, and
+// reads at a time. Records may not be larger than a block.
+const int SPILLBLOCK = 32 * 1024;
+
+// An append-only temporary file of records, for the runs of a SortedFile
+// and the partitions of the Partition class. Records are collected in a
+// buffer of the spill file's own, outside the buffer pool, and written and
+// read a block at a time; blocks are compressed if compression is on.
+// Unlike a heap file a spill file has no slots, no catalog entry and no
+// pages in the buffer pool, and it is removed when the object goes away.
+//
+// A spill file is written first, then read back with startScan() and
+// scanNext(), any number of times.
+
+class SpillFile {
+   public:
+    // create spill file fileName, which must not exist yet
+    SpillFile(const string& fileName, Status& status);
+    ~SpillFile();  // remove the file
+
+    // add a record at the end of the file
+    const Status append(const Record& rec);
+
+    // write out the records still buffered; no further appends
+    const Status finish();
+
+    // start reading from the first record (finishes the file first)
+    const Status startScan();
+
+    // the next record; rec.data stays valid until the next call of
+    // scanNext() or resetScan(). Returns FILEEOF after the last record.
+    const Status scanNext(Record& rec);
+
+    // remember the position of the record last returned by scanNext(),
+    // or the start of the file if there is none
+    const Status markScan();
+
+    // go back to the marked position; the next scanNext() returns the
+    // marked record again
+    const Status resetScan();
+
+    const string& getName() const { return fileName; }
+    int getRecCnt() const { return recCnt; }
+    long getBytes() const { return fileLen; }  // bytes on disk
+
+    // compress the blocks of spill files created from now on
+    static void setCompression(const bool on) { compression = on; }
+    static bool getCompression() { return compression; }
+
+   private:
+    const Status writeBlock();                  // write out buf
+    const Status readBlock(const long offset);  // read block at offset
+
+    string fileName;  // name of the file
+    int fd;           // unix file descriptor, -1 if not open
+    bool compress;    // blocks are compressed
+    bool finished;    // all records written out
+    int recCnt;       // number of records
+    long fileLen;     // bytes written to the file
+
+    char* buf;   // block being written or read
+    char* zbuf;  // compressed block, if compress is set
+    int bufLen;  // bytes in buf
+
+    long blockOff;      // file offset of the block in buf, -1 if none
+    long nextBlockOff;  // file offset of the block after it
+    int pos;            // offset in buf of the next record
+    int lastPos;        // offset in buf of the last record returned, or -1
+    long markBlockOff;  // block of the marked record, or -1 for the start
+    int markPos;        // offset of the marked record in its block
+
+    static bool compression;  // compress new spill files
+};
+
+#endif
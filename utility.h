@@ -28,8 +28,29 @@ using namespace std;
 
 const Status UT_Load(const string& relation, const string& fileName);
 
+const Status UT_LoadCSV(const string& relation, const string& fileName,
+                        const int numThreads);
+
 const Status UT_Print(string relation);
 
+const Status UT_Reorganize(const string& relation);
+
+// rewrite relation with its records stored as format says (as they are
+// stored now if format is NULL), in order of attribute order if that is
+// given; records returns the number of records
+struct RecFormat;
+struct ClusterAttr;
+const Status UT_Rewrite(const string& relation, const RecFormat* format,
+                        int& records, const ClusterAttr* order = NULL);
+
+const Status UT_Analyze(const string& relation);
+
+// rewrite relation in order of attribute attrName, or of the attribute it
+// was last clustered on if attrName is empty
+const Status UT_Cluster(const string& relation, const string& attrName);
+
+const Status UT_Vacuum(const string& relation);
+
 void UT_Quit(void);
 
 #endif  // UTILITY_H